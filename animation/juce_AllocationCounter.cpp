@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_ANIMATION_COUNT_ALLOCATIONS
+ namespace AllocationCounterDetail
+ {
+     // constant-initialised, so it's safe to use from operator new at any time
+     thread_local int64 numAllocations = 0;
+
+     static void* allocate (std::size_t size) noexcept
+     {
+         ++numAllocations;
+         return std::malloc (size == 0 ? 1 : size);
+     }
+
+     static void* allocateAligned (std::size_t size, std::size_t alignment) noexcept
+     {
+         ++numAllocations;
+         size = size == 0 ? 1 : size;
+
+        #if JUCE_WINDOWS
+         return _aligned_malloc (size, alignment);
+        #else
+         void* p = nullptr;
+         return posix_memalign (&p, jmax (alignment, sizeof (void*)), size) == 0 ? p : nullptr;
+        #endif
+     }
+
+     static void freeAligned (void* p) noexcept
+     {
+        #if JUCE_WINDOWS
+         _aligned_free (p);
+        #else
+         std::free (p);
+        #endif
+     }
+ }
+
+ int64 AllocationCounter::getNumAllocationsOnThisThread() noexcept
+ {
+     return AllocationCounterDetail::numAllocations;
+ }
+#else
+ int64 AllocationCounter::getNumAllocationsOnThisThread() noexcept
+ {
+     return 0;
+ }
+#endif
+
+} // namespace juce
+
+#if JUCE_ANIMATION_COUNT_ALLOCATIONS
+//==============================================================================
+// These replace the global allocation functions for the whole program.
+
+void* operator new (std::size_t size)
+{
+    if (auto* p = juce::AllocationCounterDetail::allocate (size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return juce::AllocationCounterDetail::allocate (size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    return juce::AllocationCounterDetail::allocate (size);
+}
+
+void operator delete (void* p) noexcept                                     { std::free (p); }
+void operator delete[] (void* p) noexcept                                   { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept                        { std::free (p); }
+void operator delete[] (void* p, std::size_t) noexcept                      { std::free (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept              { std::free (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept            { std::free (p); }
+
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    if (auto* p = juce::AllocationCounterDetail::allocateAligned (size, (std::size_t) alignment))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    return operator new (size, alignment);
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return juce::AllocationCounterDetail::allocateAligned (size, (std::size_t) alignment);
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return juce::AllocationCounterDetail::allocateAligned (size, (std::size_t) alignment);
+}
+
+void operator delete (void* p, std::align_val_t) noexcept                               { juce::AllocationCounterDetail::freeAligned (p); }
+void operator delete[] (void* p, std::align_val_t) noexcept                             { juce::AllocationCounterDetail::freeAligned (p); }
+void operator delete (void* p, std::size_t, std::align_val_t) noexcept                  { juce::AllocationCounterDetail::freeAligned (p); }
+void operator delete[] (void* p, std::size_t, std::align_val_t) noexcept                { juce::AllocationCounterDetail::freeAligned (p); }
+void operator delete (void* p, std::align_val_t, const std::nothrow_t&) noexcept        { juce::AllocationCounterDetail::freeAligned (p); }
+void operator delete[] (void* p, std::align_val_t, const std::nothrow_t&) noexcept      { juce::AllocationCounterDetail::freeAligned (p); }
+#endif
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Counts the heap allocations made on the calling thread, so that tests can
+    check that code which should never allocate really doesn't.
+
+    Counting works by replacing the global operator new, so it is only
+    compiled in when JUCE_ANIMATION_COUNT_ALLOCATIONS is enabled. Otherwise
+    isEnabled() returns false and every count is zero.
+
+    @code
+    const AllocationCounter::Scope allocations;
+    engine.removeAnimation (engine.addAnimation (options));
+    jassert (allocations.getNumAllocations() == 0);
+    @endcode
+
+    @see AnimationEngine::getNumAllocationsInLastTick
+*/
+class AllocationCounter
+{
+public:
+    //==============================================================================
+    /** Returns true if the module was built with JUCE_ANIMATION_COUNT_ALLOCATIONS. */
+    static constexpr bool isEnabled() noexcept      { return JUCE_ANIMATION_COUNT_ALLOCATIONS != 0; }
+
+    /** Returns the number of allocations the calling thread has made since it
+        started. This is always zero if counting isn't enabled.
+    */
+    static int64 getNumAllocationsOnThisThread() noexcept;
+
+    //==============================================================================
+    /** Counts the allocations made on the calling thread during its lifetime. */
+    class Scope
+    {
+    public:
+        Scope() noexcept  : start (getNumAllocationsOnThisThread()) {}
+
+        /** Returns the number of allocations since the scope was created. */
+        int64 getNumAllocations() const noexcept    { return getNumAllocationsOnThisThread() - start; }
+
+    private:
+        const int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (Scope)
+    };
+
+private:
+    AllocationCounter() = delete;
+};
@@ -6,13 +6,86 @@
 namespace AnimatedPositionBehaviours
 {
 
+/** The point reached by a looping, eased animation at a given time.
+
+    This is worked out directly from the absolute time since the animation
+    started, so any time can be evaluated in constant time without replaying
+    the animation up to it.
+*/
+struct EasedPhase
+{
+    /** The index of the pass the animation is in, starting from zero. */
+    int loop = 0;
+
+    /** True if the current pass runs backwards (in ping-pong mode). */
+    bool reversed = false;
+
+    /** True if the animation has completed all of its passes. */
+    bool finished = false;
+
+    /** The linear proportion through the current pass in [0, 1], with the
+        direction of the pass already applied.
+    */
+    double proportion = 0.0;
+
+    /** Works out the phase of an animation at a time in seconds since it
+        started. See Eased for the meaning of the other parameters.
+    */
+    static EasedPhase at(double time, double duration, int loops, bool pingpong) noexcept
+    {
+        EasedPhase phase;
+
+        if (duration <= 0.0)
+        {
+            phase.finished = true;
+            phase.proportion = 1.0;
+            return phase;
+        }
+
+        const double passes = std::floor(jmax(0.0, time) / duration);
+        const bool alternates = pingpong && loops != 0;
+
+        if (loops >= 0 && passes > loops)
+        {
+            // past the end, so hold the final position of the last pass
+            phase.loop = loops;
+            phase.reversed = alternates && (loops & 1) != 0;
+            phase.finished = true;
+            phase.proportion = phase.reversed ? 0.0 : 1.0;
+            return phase;
+        }
+
+        const double linear = jlimit(0.0, 1.0, (time - passes * duration) / duration);
+
+        phase.loop = passes < (double) std::numeric_limits<int>::max()
+                       ? (int) passes : std::numeric_limits<int>::max();
+        phase.reversed = alternates && std::fmod(passes, 2.0) != 0.0;
+        phase.proportion = phase.reversed ? 1.0 - linear : linear;
+        return phase;
+    }
+};
+
+//==============================================================================
 /** A behaviour that allows the animation to have an easing curve applied to it
     rather than simply following a linear interpolation.
 
     This behaviour also provides timing functionality to control the duration,
     number of loops, and loop behaviour (i.e. the auto reversing ping-pong mode)
     of the animation.
+
+    The template parameter is the type used to hold the easing function. The
+    default, Eased<>, stores it in a std::function so that the curve can be
+    chosen at runtime. If the curve is known at compile time, pass one of the
+    EasingFunctions types instead, e.g. AnimatedPosition<Eased<EaseOutCubic>>,
+    and the functor will be stored by value and inlined into each tick. To
+    choose among the built-in curves at runtime without the heap allocation a
+    std::function may make, use Eased<EasingFunctions::AnyEasing>.
+
+    The position is always derived from the absolute time since the animation
+    was released, so it can be evaluated or moved to any point in constant time
+    with evaluateAt() and seek(), e.g. to follow a transport position.
 */
+template <typename EasingFunction = std::function<double(double)>>
 class Eased
 {
     friend class AnimatedPosition<Eased>;
@@ -37,10 +110,124 @@ public:
 
     /** The easing function to use when calculating the next animation position.
 
-        If no easing function is provided the value will be interpolated
-        linearly based on the duration.
+        If the easing is a std::function and it is empty, the value will be
+        interpolated linearly based on the duration.
+    */
+    EasingFunction easing;
+
+    /** Returns the position of the animation at a time in seconds since it was
+        released. This doesn't change the state of the animation.
+    */
+    double evaluateAt(double absoluteTime) const noexcept
+    {
+        return evaluatePhase(getPhaseAt(absoluteTime));
+    }
+
+    /** Returns the velocity of the animation, in positions per second, at a
+        time in seconds since it was released.
+
+        This uses the easing's closed form derivative() if it has one, which all
+        the EasingFunctions types do, or a central difference otherwise.
+    */
+    double getVelocityAt(double absoluteTime) const noexcept
+    {
+        const auto phase = getPhaseAt(absoluteTime);
+
+        if (phase.finished)
+            return 0.0;
+
+        const double slope = hasEasing(easing) ? EasingFunctions::getDerivative(easing, phase.proportion) : 1.0;
+
+        if (phase.loop != 0)
+            return (phase.reversed ? -slope : slope) * target / duration;
+
+        const double u = phase.proportion;
+        return slope * (target - offset) / duration + velocityCorrection * (1.0 - u) * (1.0 - 3.0 * u);
+    }
+
+    /** Sends the animation towards a new target from wherever it is now, with
+        its position and velocity carrying on smoothly. If the animation has
+        finished, it leaves from where it came to rest. See the other overload.
+    */
+    void retarget(double newTarget) noexcept
+    {
+        if (settled)
+        {
+            retarget(offset, newTarget, 0.0);
+            return;
+        }
+
+        retarget(evaluateAt(time), newTarget, getVelocityAt(time));
+    }
+
+    /** Restarts the animation from a position and velocity, heading for a new
+        target, which it will reach after duration seconds.
+
+        The easing curve is rescaled to run from the position to the target, and
+        the difference between the velocity given here and the curve's own
+        starting velocity is blended out over the pass with the term
+        dv * duration * u * (1 - u)^2, where u is the linear proportion through
+        it. That term has a slope of dv at the start and vanishes, along with its
+        slope, at the end, so the motion has no jump in position or velocity and
+        still settles exactly on the target. Nothing is allocated, so this can
+        be called on every mouse move. Any later loops run between 0 and the
+        target.
+
+        If the AnimatedPosition has stopped ticking, call its endDrag() to
+        start the timer again. Don't use nudge(), which releases the behaviour
+        and so throws away the position and velocity given here.
+    */
+    void retarget(double position, double newTarget, double velocity) noexcept
+    {
+        seek(0.0);
+        offset = position;
+        target = newTarget;
+        velocityCorrection = 0.0;
+        settled = false;
+
+        if (duration > 0.0)
+            velocityCorrection = velocity - getVelocityAt(0.0);
+    }
+
+    /** Returns the position the animation is heading for. This is 1 unless it
+        has been changed with retarget().
     */
-    std::function<double(double)> easing;
+    double getTarget() const noexcept
+    {
+        return target;
+    }
+
+    /** Returns the loop index, direction and linear proportion of the animation
+        at a time in seconds since it was released.
+    */
+    EasedPhase getPhaseAt(double absoluteTime) const noexcept
+    {
+        return EasedPhase::at(absoluteTime, duration, loops, pingpong);
+    }
+
+    /** Moves the animation to a time in seconds since it was released. The next
+        tick will continue from this point.
+    */
+    void seek(double absoluteTime) noexcept
+    {
+        time = jmax(0.0, absoluteTime);
+        timeError = 0.0;
+    }
+
+    /** Returns the time in seconds since the animation was released. */
+    double getElapsedTime() const noexcept
+    {
+        return time;
+    }
+
+    /** Returns the total length of all of the animation's passes in seconds, or
+        infinity if it loops indefinitely.
+    */
+    double getTotalDuration() const noexcept
+    {
+        return loops < 0 ? std::numeric_limits<double>::infinity()
+                         : duration * (loops + 1);
+    }
 
 protected:
     /** Called by AnimatedPosition<> to provide a velocity and starting position
@@ -49,84 +236,561 @@ protected:
     */
     void releasedWithVelocity(double pos, double vel) noexcept
     {
-        time = 0.0;
+        ignoreUnused(vel);
+
+        seek(0.0);
         offset = pos;
-        currentLoop = 0;
-        pingpongStatus = false;
+        velocityCorrection = 0.0;
+        settled = false;
     }
 
-    /** Called by AnimatedPosition<> to get the next position value. This method
-        will convert the absolute milliseconds to a proportion of total elapsed
-        time divded by duration. If duration is 0 this will return the provided
+    /** Called by AnimatedPosition<> to get the next position value. This
+        advances the elapsed time and evaluates the animation at the new time
+        with evaluateAt(). If duration is 0 this will return the provided
         position and the animation will subsequently end when isStopped() is
         called afterwards.
     */
     double getNextPosition(double pos, double t) noexcept
     {
-        if (duration > 0.0)
-        {
-            time += t;
+        settled = false;
 
-            const double proportion = (pingpongStatus)
-                ? 1.0 - (time / duration)
-                : time / duration;
+        if (duration <= 0.0)
+            return pos;
 
-            if (easing == nullptr)
-                return proportion;
+        // compensated summation, so that long running loops don't drift
+        const double step = t - timeError;
+        const double newTime = time + step;
+        timeError = (newTime - time) - step;
+        time = newTime;
 
-            if (offset == 1.0)
-                return easing(1.0);
+        return evaluateAt(time);
+    }
 
-            return easing(proportion) / (1.0 / (1.0 - offset)) + offset;
-        }
-        else
-        {
+    /** Called by AnimatedPosition<> to determine whether or not the animation
+        should end. Once all the passes have completed the animation is rewound
+        so that it can be started again, starting from the position it came to
+        rest at, which is also where retarget() will leave from.
+    */
+    bool isStopped(double pos) noexcept
+    {
+        ignoreUnused(pos);
+
+        if (! getPhaseAt(time).finished)
+            return false;
+
+        offset = evaluateAt(time);
+        seek(0.0);
+        velocityCorrection = 0.0;
+        settled = true;
+        return true;
+    }
+
+    /** Applies the easing, the target, and the starting offset and velocity
+        correction to a phase. The offset and correction only apply to the
+        first pass.
+    */
+    double evaluatePhase(const EasedPhase& phase) const noexcept
+    {
+        const double eased = hasEasing(easing) ? easing(phase.proportion) : phase.proportion;
+
+        if (phase.loop != 0)
+            return eased * target;
+
+        const double u = phase.proportion;
+        const double remaining = 1.0 - u;
+
+        return eased * (target - offset) + offset
+                 + velocityCorrection * duration * u * remaining * remaining;
+    }
+
+    double time      = 0.0;
+    double timeError = 0.0;
+    double offset    = 0.0;
+    double target    = 1.0;
+    double velocityCorrection = 0.0;
+    bool settled     = false;
+
+private:
+    static bool hasEasing(const std::function<double(double)>& fn) noexcept { return fn != nullptr; }
+    static bool hasEasing(double (*fn)(double)) noexcept                    { return fn != nullptr; }
+
+    template <typename Fn>
+    static bool hasEasing(const Fn&) noexcept                               { return true; }
+};
+
+
+//==============================================================================
+/** A behaviour that plays a KeyframeTrack from its first keyframe to its last.
+
+    This replaces chaining several Eased animations together from callbacks for
+    motion with more than one stage. Times are measured from the first keyframe
+    of the track, and the animation stops once it reaches the last one.
+
+    @code
+    AnimatedPosition<AnimatedPositionBehaviours::Keyframed> pos;
+    pos.behaviour.track.addKeyframe (0.0, 0.0, EasingFunctions::EaseOutBack());
+    pos.behaviour.track.addKeyframe (0.3, 1.0);
+    pos.behaviour.track.addKeyframe (1.0, 0.5, EasingFunctions::EaseInOutSine());
+    pos.behaviour.track.addKeyframe (1.4, 0.0);
+    @endcode
+*/
+class Keyframed
+{
+    friend class AnimatedPosition<Keyframed>;
+
+public:
+    /** The keyframes to play. */
+    KeyframeTrack<double> track;
+
+    /** Returns the position at a time in seconds since the animation started. */
+    double evaluateAt(double absoluteTime) const noexcept
+    {
+        return track.getValueAt(track.getStartTime() + jmax(0.0, absoluteTime));
+    }
+
+    /** Moves the animation to a time in seconds since it started. */
+    void seek(double absoluteTime) noexcept
+    {
+        time = jmax(0.0, absoluteTime);
+    }
+
+    /** Returns the time in seconds since the animation started. */
+    double getElapsedTime() const noexcept
+    {
+        return time;
+    }
+
+protected:
+    /** Called by AnimatedPosition<> when the position is released. The track
+        always starts from its first keyframe, so the position and velocity
+        are ignored.
+    */
+    void releasedWithVelocity(double pos, double vel) noexcept
+    {
+        ignoreUnused(pos, vel);
+        seek(0.0);
+    }
+
+    /** Called by AnimatedPosition<> to get the next position value. */
+    double getNextPosition(double pos, double t) noexcept
+    {
+        if (track.getNumKeyframes() == 0)
             return pos;
-        }
+
+        time += t;
+        return evaluateAt(time);
     }
 
-    /** Called by AnimatedPosition<> to determine whether or not the animation
-        should end. This method handles the duration, looping, and ping-pong
-        logic.
+    /** Called by AnimatedPosition<> to determine whether the track has finished.
+        The animation is reset once it has, so that it can be started again.
     */
     bool isStopped(double pos) noexcept
     {
-        if (time >= duration)
-        {
-            time   = 0.0;
-            offset = 0.0;
+        ignoreUnused(pos);
+
+        if (time < track.getDuration())
+            return false;
+
+        seek(0.0);
+        return true;
+    }
+
+    double time = 0.0;
+};
+
+//==============================================================================
+/** A behaviour that moves the position towards a target like a damped spring,
+    starting from the position and velocity at which it was released.
+
+    The motion is evaluated analytically rather than integrated tick by tick,
+    so every tick costs the same regardless of the timestep, the result doesn't
+    depend on the frame rate, and any time can be evaluated directly with
+    evaluateAt(). Under-damped, critically damped and over-damped springs are
+    all supported, depending on how damping compares to 2 * sqrt (mass *
+    stiffness).
+
+    When the spring is released, the time at which it settles to within
+    settleTolerance of the target is worked out exactly from the envelope of
+    the motion, and the animation stops as soon as that time is reached, with
+    its last step landing exactly on the target.
+*/
+class Spring
+{
+    friend class AnimatedPosition<Spring>;
+
+public:
+    /** The position the spring pulls towards. */
+    double target = 0.0;
+
+    /** The mass on the end of the spring. Must be greater than zero. */
+    double mass = 1.0;
+
+    /** The stiffness of the spring. Must be greater than zero. */
+    double stiffness = 100.0;
+
+    /** The damping applied to the motion. */
+    double damping = 20.0;
 
-            if (loops != 0)
+    /** The animation stops once its distance from the target can no longer
+        exceed this value.
+    */
+    double settleTolerance = 1.0e-3;
+
+    /** Returns the position at a time in seconds since the spring was released.
+        From the settle time onwards, this is exactly the target.
+    */
+    double evaluateAt(double absoluteTime) const noexcept
+    {
+        const double t = jmax(0.0, absoluteTime);
+
+        if (t >= settleTime)
+            return target;
+
+        switch (mode)
+        {
+            case Mode::underDamped:
             {
-                if (pingpong)
-                    pingpongStatus = !pingpongStatus;
-
-                if (loops > 0)
-                {
-                    if (currentLoop >= loops)
-                    {
-                        currentLoop = 0;
-                        return true;
-                    }
-                    else
-                    {
-                        currentLoop++;
-                    }
-                }
+                const double phase = dampedFrequency * t;
+                return target + std::exp(-decay * t) * (c1 * std::cos(phase) + c2 * std::sin(phase));
             }
-            else
+
+            case Mode::criticallyDamped:
+                return target + (c1 + c2 * t) * std::exp(-decay * t);
+
+            case Mode::overDamped:
+                return target + c1 * std::exp(rate1 * t) + c2 * std::exp(rate2 * t);
+        }
+
+        return target;
+    }
+
+    /** Returns the velocity at a time in seconds since the spring was released.
+        From the settle time onwards, this is zero.
+    */
+    double getVelocityAt(double absoluteTime) const noexcept
+    {
+        const double t = jmax(0.0, absoluteTime);
+
+        if (t >= settleTime)
+            return 0.0;
+
+        switch (mode)
+        {
+            case Mode::underDamped:
             {
-                return true;
+                const double phase = dampedFrequency * t;
+                const double cosine = std::cos(phase), sine = std::sin(phase);
+
+                return std::exp(-decay * t)
+                         * ((c2 * dampedFrequency - decay * c1) * cosine
+                            - (c1 * dampedFrequency + decay * c2) * sine);
             }
+
+            case Mode::criticallyDamped:
+                return (c2 - decay * (c1 + c2 * t)) * std::exp(-decay * t);
+
+            case Mode::overDamped:
+                return c1 * rate1 * std::exp(rate1 * t) + c2 * rate2 * std::exp(rate2 * t);
+        }
+
+        return 0.0;
+    }
+
+    /** Returns the time in seconds after release at which the spring settles,
+        or infinity if it never will (i.e. if it has no damping).
+    */
+    double getSettleTime() const noexcept
+    {
+        return settleTime;
+    }
+
+    /** Moves the target and restarts the motion from a position and velocity,
+        in the same way as when the spring is released. This is how values
+        coming from an AnimationUpdateQueue are usually applied.
+
+        The AnimatedPosition only ticks while its timer is running, so if the
+        spring had already settled, call its endDrag() to start it moving
+        again. Don't use nudge(), which releases the spring a second time, from
+        the AnimatedPosition's own position and velocity.
+    */
+    void retarget(double position, double newTarget, double velocity) noexcept
+    {
+        target = newTarget;
+        releasedWithVelocity(position, velocity);
+    }
+
+    /** Returns the time in seconds since the spring was released. */
+    double getElapsedTime() const noexcept
+    {
+        return time;
+    }
+
+    /** Moves the animation to a time in seconds since it was released. */
+    void seek(double absoluteTime) noexcept
+    {
+        time = jmax(0.0, absoluteTime);
+    }
+
+protected:
+    /** Called by AnimatedPosition<> when the position is released. This solves
+        for the motion starting from this position and velocity.
+    */
+    void releasedWithVelocity(double pos, double vel) noexcept
+    {
+        jassert(mass > 0.0 && stiffness > 0.0 && damping >= 0.0);
+
+        time = 0.0;
+
+        const double x0 = pos - target;
+        const double naturalFrequency = std::sqrt(stiffness / mass);
+        const double ratio = damping / (2.0 * std::sqrt(stiffness * mass));
+
+        if (std::abs(ratio - 1.0) < 1.0e-9)
+        {
+            mode = Mode::criticallyDamped;
+            decay = naturalFrequency;
+            c1 = x0;
+            c2 = vel + naturalFrequency * x0;
+        }
+        else if (ratio < 1.0)
+        {
+            mode = Mode::underDamped;
+            decay = ratio * naturalFrequency;
+            dampedFrequency = naturalFrequency * std::sqrt(1.0 - ratio * ratio);
+            c1 = x0;
+            c2 = (vel + decay * x0) / dampedFrequency;
+        }
+        else
+        {
+            mode = Mode::overDamped;
+            const double root = naturalFrequency * std::sqrt(ratio * ratio - 1.0);
+            rate1 = -ratio * naturalFrequency + root;
+            rate2 = -ratio * naturalFrequency - root;
+            c2 = (vel - rate1 * x0) / (rate2 - rate1);
+            c1 = x0 - c2;
         }
 
+        settleTime = calculateSettleTime();
+    }
+
+    /** Called by AnimatedPosition<> to get the next position value. */
+    double getNextPosition(double pos, double t) noexcept
+    {
+        ignoreUnused(pos);
+
+        time += t;
+        return evaluateAt(time);
+    }
+
+    /** Called by AnimatedPosition<> to determine whether the spring has settled. */
+    bool isStopped(double pos) noexcept
+    {
+        ignoreUnused(pos);
+        return time >= settleTime;
+    }
+
+private:
+    enum class Mode { underDamped, criticallyDamped, overDamped };
+
+    /** Finds the time after which the envelope of the motion stays within the
+        tolerance. For an under-damped spring this has a closed form; for the
+        other two the envelope is unimodal, so its last crossing is found by
+        bisection once it is known to be falling.
+    */
+    double calculateSettleTime() const noexcept
+    {
+        const double tolerance = jmax(settleTolerance, std::numeric_limits<double>::min());
+
+        if (mode == Mode::underDamped)
+        {
+            const double envelope = std::sqrt(c1 * c1 + c2 * c2);
+
+            if (envelope <= tolerance)
+                return 0.0;
+
+            if (decay <= 0.0)
+                return std::numeric_limits<double>::infinity();
+
+            return std::log(envelope / tolerance) / decay;
+        }
+
+        auto envelopeAt = [this] (double t)
+        {
+            if (mode == Mode::criticallyDamped)
+                return (std::abs(c1) + std::abs(c2) * t) * std::exp(-decay * t);
+
+            return std::abs(c1) * std::exp(rate1 * t) + std::abs(c2) * std::exp(rate2 * t);
+        };
+
+        // the critically damped envelope peaks before it starts to fall
+        double low = 0.0;
+
+        if (mode == Mode::criticallyDamped && c2 != 0.0)
+            low = jmax(0.0, 1.0 / decay - std::abs(c1) / std::abs(c2));
+
+        if (envelopeAt(low) <= tolerance)
+            return low;
+
+        double high = jmax(low, 1.0e-3);
+
+        while (envelopeAt(high) > tolerance)
+        {
+            low = high;
+            high *= 2.0;
+
+            if (high > 1.0e9)
+                return std::numeric_limits<double>::infinity();
+        }
+
+        for (int i = 0; i < 64 && high - low > 1.0e-9 * high; ++i)
+        {
+            const double mid = 0.5 * (low + high);
+            (envelopeAt(mid) > tolerance ? low : high) = mid;
+        }
+
+        return high;
+    }
+
+    Mode mode = Mode::criticallyDamped;
+    double time = 0.0, settleTime = 0.0;
+    double c1 = 0.0, c2 = 0.0;
+    double decay = 0.0, dampedFrequency = 0.0, rate1 = 0.0, rate2 = 0.0;
+};
+
+//==============================================================================
+/** Steps another behaviour at a constant rate, however unevenly the timer fires.
+
+    The time delivered by AnimatedPosition<> is collected, and the wrapped
+    behaviour is advanced in whole steps of 1 / stepsPerSecond, so anything it
+    integrates behaves the same at any frame rate. The position shown is
+    interpolated between the last two steps by the time left over, which
+    keeps the motion smooth when the frame rate and the step rate don't
+    divide evenly, at the cost of being up to one step behind.
+
+    After a hitch, at most maxStepsPerFrame steps are taken in one frame and
+    the rest of the missed time is dropped, so the animation slows down
+    through the hitch instead of the stepping cost growing frame after frame.
+
+    The wrapped behaviour's settings are inherited, so they're set directly:
+
+    @code
+    AnimatedPosition<AnimatedPositionBehaviours::FixedTimestep<AnimatedPositionBehaviours::Spring>> pos;
+    pos.behaviour.stepsPerSecond = 240.0;
+    pos.behaviour.stiffness = 300.0;
+    @endcode
+*/
+template <typename Behaviour>
+class FixedTimestep  : public Behaviour
+{
+    friend class AnimatedPosition<FixedTimestep>;
+
+public:
+    /** The number of times per second that the wrapped behaviour is stepped. */
+    double stepsPerSecond = 120.0;
+
+    /** The most steps taken in one frame. Time beyond this is dropped. */
+    int maxStepsPerFrame = 8;
+
+    /** Whether the position shown is interpolated between the last two steps,
+        or is simply the latest step.
+    */
+    bool interpolate = true;
+
+    /** Returns the number of steps taken in the last frame. */
+    int getNumStepsInLastFrame() const noexcept
+    {
+        return numStepsInLastFrame;
+    }
+
+    /** Returns the total time dropped after hitches since the behaviour was
+        last released.
+    */
+    double getDroppedTime() const noexcept
+    {
+        return droppedTime;
+    }
+
+protected:
+    /** Called by AnimatedPosition<> when the position is released. This
+        releases the wrapped behaviour and starts stepping it afresh.
+    */
+    void releasedWithVelocity(double pos, double vel) noexcept
+    {
+        Behaviour::releasedWithVelocity(pos, vel);
+
+        previous = current = pos;
+        accumulator = droppedTime = 0.0;
+        numStepsInLastFrame = 0;
+        finishing = false;
+    }
+
+    /** Called by AnimatedPosition<> to get the next position value. This takes
+        as many whole steps as the collected time allows, up to
+        maxStepsPerFrame, and interpolates between the last two.
+    */
+    double getNextPosition(double pos, double t) noexcept
+    {
+        ignoreUnused(pos);
+        jassert(stepsPerSecond > 0.0 && maxStepsPerFrame > 0);
+
+        if (finishing)
+            return current;
+
+        const double step = 1.0 / stepsPerSecond;
+
+        accumulator += jmax(0.0, t);
+        numStepsInLastFrame = 0;
+
+        while (accumulator >= step && numStepsInLastFrame < maxStepsPerFrame)
+        {
+            previous = current;
+            current = Behaviour::getNextPosition(current, step);
+            accumulator -= step;
+            ++numStepsInLastFrame;
+        }
+
+        if (accumulator >= step)
+        {
+            // keep the fraction of a step, so the interpolation stays smooth
+            const double excess = std::floor(accumulator / step) * step;
+            droppedTime += excess;
+            accumulator -= excess;
+        }
+
+        if (! interpolate)
+            return current;
+
+        return previous + (current - previous) * jlimit(0.0, 1.0, accumulator / step);
+    }
+
+    /** Called by AnimatedPosition<> to determine whether the animation should
+        end. Once the wrapped behaviour has stopped, one more frame is given
+        over to showing its final position if the interpolated one hadn't
+        reached it.
+    */
+    bool isStopped(double pos) noexcept
+    {
+        if (finishing)
+        {
+            finishing = false;
+            return true;
+        }
+
+        if (! Behaviour::isStopped(current))
+            return false;
+
+        if (pos == current)
+            return true;
+
+        finishing = true;
         return false;
     }
 
-    double time   = 0.0;
-    double offset = 0.0;
-    int currentLoop = 0;
-    bool pingpongStatus = false;
+private:
+    double previous = 0.0, current = 0.0;
+    double accumulator = 0.0, droppedTime = 0.0;
+    int numStepsInLastFrame = 0;
+    bool finishing = false;
 };
 
 }
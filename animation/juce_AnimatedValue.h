@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Describes how a type is split into doubles so that AnimatedValue can
+    interpolate it.
+
+    Specialise this for your own types. A specialisation needs the number of
+    components and functions to convert to and from an array of them:
+
+    @code
+    struct GainPan { double gain, pan; };
+
+    namespace juce
+    {
+        template <>
+        struct AnimatedValueTraits<GainPan>
+        {
+            static constexpr int numComponents = 2;
+
+            static void toComponents (const GainPan& v, double* c) noexcept   { c[0] = v.gain; c[1] = v.pan; }
+            static GainPan fromComponents (const double* c) noexcept          { return { c[0], c[1] }; }
+        };
+    }
+    @endcode
+
+    Specialisations are provided for float and double and, when juce_gui_basics
+    is available, for Point, Rectangle, Colour and AffineTransform.
+*/
+template <typename ValueType>
+struct AnimatedValueTraits;
+
+namespace AnimatedValueDetail
+{
+    /** Converts a component back to its original type, rounding it if the type
+        is an integer.
+    */
+    template <typename Type>
+    Type fromComponent (double component) noexcept
+    {
+        if constexpr (std::is_integral<Type>::value)
+            return (Type) roundToInt (component);
+        else
+            return (Type) component;
+    }
+
+    template <typename Type>
+    struct ArithmeticTraits
+    {
+        static constexpr int numComponents = 1;
+
+        static void toComponents (Type v, double* c) noexcept       { c[0] = (double) v; }
+        static Type fromComponents (const double* c) noexcept       { return fromComponent<Type> (c[0]); }
+    };
+}
+
+template <> struct AnimatedValueTraits<float>   : AnimatedValueDetail::ArithmeticTraits<float>  {};
+template <> struct AnimatedValueTraits<double>  : AnimatedValueDetail::ArithmeticTraits<double> {};
+
+#if JUCE_MODULE_AVAILABLE_juce_gui_basics
+
+template <typename ValueType>
+struct AnimatedValueTraits<Point<ValueType>>
+{
+    static constexpr int numComponents = 2;
+
+    static void toComponents (Point<ValueType> p, double* c) noexcept
+    {
+        c[0] = (double) p.getX();
+        c[1] = (double) p.getY();
+    }
+
+    static Point<ValueType> fromComponents (const double* c) noexcept
+    {
+        using namespace AnimatedValueDetail;
+        return { fromComponent<ValueType> (c[0]), fromComponent<ValueType> (c[1]) };
+    }
+};
+
+template <typename ValueType>
+struct AnimatedValueTraits<Rectangle<ValueType>>
+{
+    static constexpr int numComponents = 4;
+
+    static void toComponents (const Rectangle<ValueType>& r, double* c) noexcept
+    {
+        c[0] = (double) r.getX();
+        c[1] = (double) r.getY();
+        c[2] = (double) r.getWidth();
+        c[3] = (double) r.getHeight();
+    }
+
+    static Rectangle<ValueType> fromComponents (const double* c) noexcept
+    {
+        using namespace AnimatedValueDetail;
+        return { fromComponent<ValueType> (c[0]), fromComponent<ValueType> (c[1]),
+                 fromComponent<ValueType> (c[2]), fromComponent<ValueType> (c[3]) };
+    }
+};
+
+/** Colours are interpolated in unpremultiplied RGBA. */
+template <>
+struct AnimatedValueTraits<Colour>
+{
+    static constexpr int numComponents = 4;
+
+    static void toComponents (Colour colour, double* c) noexcept
+    {
+        c[0] = colour.getFloatRed();
+        c[1] = colour.getFloatGreen();
+        c[2] = colour.getFloatBlue();
+        c[3] = colour.getFloatAlpha();
+    }
+
+    static Colour fromComponents (const double* c) noexcept
+    {
+        return Colour::fromFloatRGBA ((float) c[0], (float) c[1], (float) c[2], (float) c[3]);
+    }
+};
+
+/** Transforms are interpolated matrix element by matrix element, which suits
+    translations and scales. Interpolating between rotations this way will
+    shear the intermediate frames.
+*/
+template <>
+struct AnimatedValueTraits<AffineTransform>
+{
+    static constexpr int numComponents = 6;
+
+    static void toComponents (const AffineTransform& t, double* c) noexcept
+    {
+        c[0] = t.mat00;  c[1] = t.mat01;  c[2] = t.mat02;
+        c[3] = t.mat10;  c[4] = t.mat11;  c[5] = t.mat12;
+    }
+
+    static AffineTransform fromComponents (const double* c) noexcept
+    {
+        return { (float) c[0], (float) c[1], (float) c[2],
+                 (float) c[3], (float) c[4], (float) c[5] };
+    }
+};
+
+#endif
+
+//==============================================================================
+/**
+    Animates a value with several components, such as a Rectangle or a Colour,
+    as a single unit.
+
+    Animating a component's bounds with AnimatedPosition takes four separate
+    animations, each with its own timer and easing call. An AnimatedValue
+    evaluates its easing once per frame and then interpolates all of the
+    components together with a vectorised lerp.
+
+    @code
+    AnimatedValue<Rectangle<int>> bounds { button.getBounds(), target, 0.3,
+                                           EasingFunctions::EaseOutCubic() };
+
+    // each frame
+    button.setBounds (bounds.advance (deltaSeconds));
+    @endcode
+
+    It can also be driven by an AnimationEngine, by animating a proportion from
+    0 to 1 and passing it to interpolate():
+
+    @code
+    AnimationEngine::Options options;
+    options.duration = 0.3;
+    options.easing   = engine.addEasing (EasingFunctions::EaseOutCubic());
+    options.onUpdate = [this] (double p) { button.setBounds (bounds.interpolate (p)); };
+    engine.addAnimation (options);
+    @endcode
+
+    Any type with an AnimatedValueTraits specialisation can be animated.
+*/
+template <typename ValueType, typename EasingFunction = EasingFunctions::AnyEasing>
+class AnimatedValue
+{
+public:
+    //==============================================================================
+    using Traits = AnimatedValueTraits<ValueType>;
+    static constexpr int numComponents = Traits::numComponents;
+
+    /** Creates an animation between two default-constructed values. */
+    AnimatedValue() = default;
+
+    /** Creates an animation between two values. */
+    AnimatedValue (const ValueType& startValue, const ValueType& endValue,
+                   double durationSeconds, const EasingFunction& easingToUse = {})
+        : duration (durationSeconds), easing (easingToUse)
+    {
+        setRange (startValue, endValue);
+    }
+
+    //==============================================================================
+    /** The duration of the animation in seconds. If this is zero the value
+        jumps straight to the end.
+    */
+    double duration = 0.0;
+
+    /** The curve applied to the proportion of the duration that has elapsed. */
+    EasingFunction easing {};
+
+    //==============================================================================
+    /** Changes the values to animate between and rewinds to the start. */
+    void setRange (const ValueType& newStart, const ValueType& newEnd) noexcept
+    {
+        Traits::toComponents (newStart, start.data());
+        Traits::toComponents (newEnd, end.data());
+
+        for (int i = 0; i < numComponents; ++i)
+            delta[(size_t) i] = end[(size_t) i] - start[(size_t) i];
+
+        elapsed = 0.0;
+    }
+
+    /** Starts a new animation from the current value to a new end value. */
+    void retarget (const ValueType& newEnd) noexcept
+    {
+        setRange (getValue(), newEnd);
+    }
+
+    /** Returns the value the animation starts from. */
+    ValueType getStart() const noexcept                 { return Traits::fromComponents (start.data()); }
+
+    /** Returns the value the animation ends at. */
+    ValueType getEnd() const noexcept                   { return Traits::fromComponents (end.data()); }
+
+    //==============================================================================
+    /** Moves the animation on by a number of seconds and returns the new value. */
+    ValueType advance (double deltaSeconds) noexcept
+    {
+        elapsed = jmin (elapsed + deltaSeconds, jmax (0.0, duration));
+        return getValue();
+    }
+
+    /** Moves the animation to a time in seconds since it started. */
+    void seek (double time) noexcept                    { elapsed = jlimit (0.0, jmax (0.0, duration), time); }
+
+    /** Returns the time in seconds since the animation started. */
+    double getElapsedTime() const noexcept              { return elapsed; }
+
+    /** Returns true once the animation has reached its end value. */
+    bool isFinished() const noexcept                    { return elapsed >= duration; }
+
+    //==============================================================================
+    /** Returns the current value. */
+    ValueType getValue() const noexcept                 { return getValueAt (elapsed); }
+
+    /** Returns the value at a time in seconds since the animation started. This
+        doesn't change the state of the animation.
+    */
+    ValueType getValueAt (double time) const noexcept
+    {
+        if (duration <= 0.0 || time >= duration)
+            return getEnd();
+
+        return interpolate (easing (jmax (0.0, time / duration)));
+    }
+
+    /** Returns the value at a proportion between the start and end values that
+        has already been eased.
+    */
+    ValueType interpolate (double easedProportion) const noexcept
+    {
+        if (easedProportion == 1.0)
+            return getEnd();
+
+        std::array<double, (size_t) numComponents> result;
+        lerp (easedProportion, result.data());
+        return Traits::fromComponents (result.data());
+    }
+
+private:
+    //==============================================================================
+    void lerp (double proportion, double* result) const noexcept
+    {
+        using namespace EasingFunctions::SIMDDetail;
+
+        constexpr int step = NativeRegister::size;
+        const NativeRegister p (proportion);
+
+        int i = 0;
+
+        for (; i + step <= numComponents; i += step)
+            (NativeRegister::load (start.data() + i) + NativeRegister::load (delta.data() + i) * p).store (result + i);
+
+        for (; i < numComponents; ++i)
+            result[i] = start[(size_t) i] + delta[(size_t) i] * proportion;
+    }
+
+    std::array<double, (size_t) numComponents> start {}, end {}, delta {};
+    double elapsed = 0.0;
+};
@@ -0,0 +1,1513 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+//==============================================================================
+void AnimationEngine::State::reserve (int numAnimations)
+{
+    ids.ensureStorageAllocated (numAnimations);
+    elapsed.ensureStorageAllocated (numAnimations);
+    duration.ensureStorageAllocated (numAnimations);
+    startValue.ensureStorageAllocated (numAnimations);
+    endValue.ensureStorageAllocated (numAnimations);
+    proportion.ensureStorageAllocated (numAnimations);
+    value.ensureStorageAllocated (numAnimations);
+    loops.ensureStorageAllocated (numAnimations);
+    currentLoop.ensureStorageAllocated (numAnimations);
+    easing.ensureStorageAllocated (numAnimations);
+    flags.ensureStorageAllocated (numAnimations);
+    onUpdate.ensureStorageAllocated (numAnimations);
+    onFinished.ensureStorageAllocated (numAnimations);
+}
+
+void AnimationEngine::State::add (AnimationId id, const Options& options)
+{
+    ids.add (id);
+    elapsed.add (0.0);
+    duration.add (options.duration);
+    startValue.add (options.startValue);
+    endValue.add (options.endValue);
+    proportion.add (0.0);
+    value.add (options.startValue);
+    loops.add (options.loops);
+    currentLoop.add (0);
+    easing.add (options.easing);
+    flags.add (options.pingpong ? (uint8) pingpongFlag : (uint8) 0);
+    onUpdate.add (options.onUpdate);
+    onFinished.add (options.onFinished);
+}
+
+void AnimationEngine::State::removeAt (int index)
+{
+    const int last = size() - 1;
+
+    if (index != last)
+    {
+        ids.swap (index, last);
+        elapsed.swap (index, last);
+        duration.swap (index, last);
+        startValue.swap (index, last);
+        endValue.swap (index, last);
+        proportion.swap (index, last);
+        value.swap (index, last);
+        loops.swap (index, last);
+        currentLoop.swap (index, last);
+        easing.swap (index, last);
+        flags.swap (index, last);
+        onUpdate.swap (index, last);
+        onFinished.swap (index, last);
+    }
+
+    ids.removeLast();
+    elapsed.removeLast();
+    duration.removeLast();
+    startValue.removeLast();
+    endValue.removeLast();
+    proportion.removeLast();
+    value.removeLast();
+    loops.removeLast();
+    currentLoop.removeLast();
+    easing.removeLast();
+    flags.removeLast();
+    onUpdate.removeLast();
+    onFinished.removeLast();
+}
+
+//==============================================================================
+/** Runs evaluate() on a worker thread.
+
+    While this exists the worker owns the engine's state arrays. The message
+    thread sends it additions, removals, retargets and new curves as commands
+    (the worker keeps its own list of the curves, so that registering one
+    never waits for an evaluation), and gets
+    back the values of the running animations through a triple buffer, and
+    the animations that have finished through a separate list (so that none
+    are lost if the message thread skips a frame).
+*/
+class AnimationEngine::BackgroundEvaluator  : private Thread
+{
+public:
+    struct Command
+    {
+        enum class Type { add, remove, retarget, removeAll, addCurve, reserve };
+
+        Type type;
+        AnimationId id;
+        Curve* curve = nullptr;
+        double duration = 0.0, startValue = 0.0, endValue = 0.0;
+        int loops = 0, easing = 0, capacity = 0;
+        bool pingpong = false;
+    };
+
+    struct Frame
+    {
+        Array<AnimationId> ids;
+        Array<double> values;
+        double evaluationMs = 0.0;
+    };
+
+    struct Finished
+    {
+        AnimationId id;
+        double value;
+    };
+
+    explicit BackgroundEvaluator (AnimationEngine& e)
+        : Thread ("AnimationEngine"), engine (e)
+    {
+        for (int i = 0; i < engine.state.size(); ++i)
+            setIndexOfSlot (engine.state.ids.getUnchecked (i).slot, i);
+
+        for (auto* curve : engine.curves)
+            curves.add (curve);
+
+        startThread();
+    }
+
+    ~BackgroundEvaluator() override
+    {
+        stop();
+    }
+
+    /** Stops the worker. Anything it didn't get round to is applied here, so
+        that the state is complete when the message thread takes it back.
+    */
+    void stop()
+    {
+        signalThreadShouldExit();
+        workToDo.signal();
+        stopThread (-1);
+
+        applyCommands();
+    }
+
+    //==============================================================================
+    // message thread
+
+    void post (const Command& command)
+    {
+        const ScopedLock sl (lock);
+        commands.add (command);
+    }
+
+    void requestFrame (double deltaSeconds)
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingDelta += deltaSeconds;
+        }
+
+        workToDo.signal();
+    }
+
+    /** Swaps the most recently published frame to the front, if there is one. */
+    bool acquireFrame() noexcept
+    {
+        if ((middle.load (std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+
+        front = middle.exchange (front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const Frame& getFrontFrame() const noexcept         { return frames[front]; }
+
+    /** Returns the animations that have finished since the last call. */
+    const Array<Finished>& takeFinished()
+    {
+        delivered.clearQuick();
+
+        const ScopedLock sl (lock);
+        delivered.swapWith (finished);
+        return delivered;
+    }
+
+private:
+    //==============================================================================
+    // worker thread
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            workToDo.wait (-1);
+
+            if (threadShouldExit())
+                break;
+
+            double deltaSeconds;
+
+            {
+                const ScopedLock sl (lock);
+                deltaSeconds = pendingDelta;
+                pendingDelta = 0.0;
+            }
+
+            applyCommands();
+
+            const auto startTicks = Time::getHighResolutionTicks();
+
+            {
+                const ScopedLock sl (engine.evaluationLock);
+                engine.evaluate (deltaSeconds, curves.getRawDataPointer(), curves.size());
+            }
+
+            publish (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1000.0);
+        }
+    }
+
+    void applyCommands()
+    {
+        {
+            const ScopedLock sl (lock);
+            workingCommands.swapWith (commands);
+        }
+
+        auto& state = engine.state;
+
+        for (const auto& c : workingCommands)
+        {
+            if (c.type == Command::Type::addCurve)
+            {
+                curves.add (c.curve);
+                continue;
+            }
+
+            if (c.type == Command::Type::reserve)
+            {
+                engine.reserveEvaluationStorage (c.capacity);
+                indexOfSlot.ensureStorageAllocated (c.capacity);
+                continue;
+            }
+
+            if (c.type == Command::Type::removeAll)
+            {
+                while (state.size() > 0)
+                    removeAt (state.size() - 1);
+
+                continue;
+            }
+
+            if (c.type == Command::Type::add)
+            {
+                Options options;
+                options.duration = c.duration;
+                options.loops = c.loops;
+                options.pingpong = c.pingpong;
+                options.startValue = c.startValue;
+                options.endValue = c.endValue;
+                options.easing = c.easing;
+
+                setIndexOfSlot (c.id.slot, state.size());
+                state.add (c.id, options);
+                continue;
+            }
+
+            const int index = indexOf (c.id);
+
+            if (index < 0)
+                continue;
+
+            if (c.type == Command::Type::remove)
+                removeAt (index);
+            else
+                engine.retargetAt (index, c.endValue);
+        }
+
+        workingCommands.clearQuick();
+    }
+
+    void publish (double evaluationMs)
+    {
+        auto& state = engine.state;
+        auto& frame = frames[back];
+
+        frame.ids.clearQuick();
+        frame.values.clearQuick();
+        frame.evaluationMs = evaluationMs;
+
+        for (int i = 0; i < state.size(); ++i)
+        {
+            if ((state.flags.getUnchecked (i) & finishedFlag) == 0)
+            {
+                frame.ids.add (state.ids.getUnchecked (i));
+                frame.values.add (state.value.getUnchecked (i));
+            }
+        }
+
+        // collected outside the lock, so that the message thread is never
+        // held up by a scan of the state
+        for (int i = 0; i < state.size(); ++i)
+            if ((state.flags.getUnchecked (i) & finishedFlag) != 0)
+                newlyFinished.add ({ state.ids.getUnchecked (i), state.value.getUnchecked (i) });
+
+        if (! newlyFinished.isEmpty())
+        {
+            const ScopedLock sl (lock);
+
+            if (finished.isEmpty())
+                finished.swapWith (newlyFinished);
+            else
+                finished.addArray (newlyFinished);
+        }
+
+        newlyFinished.clearQuick();
+
+        for (int i = state.size(); --i >= 0;)
+            if ((state.flags.getUnchecked (i) & finishedFlag) != 0)
+                removeAt (i);
+
+        back = middle.exchange (back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    //==============================================================================
+    void setIndexOfSlot (int slot, int index)
+    {
+        while (indexOfSlot.size() <= slot)
+            indexOfSlot.add (-1);
+
+        indexOfSlot.set (slot, index);
+    }
+
+    int indexOf (AnimationId id) const noexcept
+    {
+        const int index = isPositiveAndBelow (id.slot, indexOfSlot.size()) ? indexOfSlot.getUnchecked (id.slot) : -1;
+        return (index >= 0 && engine.state.ids.getUnchecked (index) == id) ? index : -1;
+    }
+
+    void removeAt (int index)
+    {
+        auto& state = engine.state;
+
+        indexOfSlot.set (state.ids.getUnchecked (index).slot, -1);
+        state.removeAt (index);
+
+        if (index < state.size())
+            indexOfSlot.set (state.ids.getUnchecked (index).slot, index);
+    }
+
+    //==============================================================================
+    static constexpr int indexMask = 3, freshBit = 4;
+
+    AnimationEngine& engine;
+
+    CriticalSection lock;
+    Array<Command> commands, workingCommands;
+    Array<Finished> finished, delivered, newlyFinished;
+    Array<Curve*> curves;
+    double pendingDelta = 0.0;
+    WaitableEvent workToDo;
+
+    Array<int> indexOfSlot;
+
+    Frame frames[3];
+    int front = 0, back = 1;
+    std::atomic<int> middle { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE (BackgroundEvaluator)
+};
+
+//==============================================================================
+/** Spreads evaluate() over a pool of threads.
+
+    The animations are split into chunks whose size is a whole number of cache
+    lines for every state array, so neighbouring chunks only ever share the
+    line at their boundary. Each thread taking part in a tick starts with a
+    contiguous run of chunks, held as a [begin, end) pair packed into one
+    atomic. It takes chunks from the front of its own run, and once that's
+    empty steals them one at a time from the back of the others'. The thread
+    calling run() is thread 0, and doesn't return until every chunk is done.
+*/
+class AnimationEngine::EvaluationPool
+{
+public:
+    /** Chunks are 2048 animations: 256 cache lines of doubles, 32 of bytes. */
+    static constexpr int chunkSize = 2048;
+
+    EvaluationPool (AnimationEngine& e, int numThreadsToUse)
+        : engine (e),
+          numThreads (numThreadsToUse),
+          threads (new ThreadState[(size_t) numThreadsToUse])
+    {
+        for (int i = 1; i < numThreads; ++i)
+            workers.add (new Worker (*this, i));
+    }
+
+    ~EvaluationPool()
+    {
+        for (auto* worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto* worker : workers)
+            worker->wake.signal();
+
+        workers.clear();
+    }
+
+    int getNumThreads() const noexcept              { return numThreads; }
+
+    /** Evaluates a tick on the first numThreadsToUse threads of the pool. */
+    void run (double deltaSeconds, int numAnimations, int numThreadsToUse)
+    {
+        jassert (numThreadsToUse > 1 && numThreadsToUse <= numThreads);
+
+        const int numChunks = (numAnimations + chunkSize - 1) / chunkSize;
+
+        tickDelta = deltaSeconds;
+        tickSize = numAnimations;
+        chunksRemaining.store (numChunks, std::memory_order_relaxed);
+
+        // contiguous runs, so that each thread mostly works through memory in
+        // order; the release publishes the tick's parameters to the workers
+        for (int i = 0; i < numThreadsToUse; ++i)
+        {
+            const auto begin = (uint32) ((int64) numChunks * i / numThreadsToUse);
+            const auto end   = (uint32) ((int64) numChunks * (i + 1) / numThreadsToUse);
+            threads[(size_t) i].range.store (pack (begin, end), std::memory_order_release);
+        }
+
+        for (int i = 1; i < numThreadsToUse; ++i)
+            workers.getUnchecked (i - 1)->wake.signal();
+
+        processChunks (0, numThreadsToUse);
+
+        // the other threads can only be part-way through their last chunk
+        while (chunksRemaining.load (std::memory_order_acquire) > 0)
+            Thread::yield();
+    }
+
+private:
+    //==============================================================================
+    struct alignas (64) ThreadState
+    {
+        std::atomic<uint64> range { 0 };
+        PoolArray<int> curveCounts;
+    };
+
+    class Worker  : public Thread
+    {
+    public:
+        Worker (EvaluationPool& p, int index)
+            : Thread ("AnimationEngine evaluation"), pool (p), threadIndex (index)
+        {
+            startThread();
+        }
+
+        ~Worker() override
+        {
+            stopThread (-1);
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wake.wait (-1);
+
+                if (! threadShouldExit())
+                    pool.processChunks (threadIndex, pool.numThreads);
+            }
+        }
+
+        WaitableEvent wake;
+
+    private:
+        EvaluationPool& pool;
+        const int threadIndex;
+    };
+
+    //==============================================================================
+    static uint64 pack (uint32 begin, uint32 end) noexcept     { return ((uint64) end << 32) | begin; }
+    static uint32 getBegin (uint64 range) noexcept             { return (uint32) range; }
+    static uint32 getEnd (uint64 range) noexcept               { return (uint32) (range >> 32); }
+
+    int takeOwnChunk (int threadIndex) noexcept
+    {
+        auto& range = threads[(size_t) threadIndex].range;
+        auto r = range.load (std::memory_order_acquire);
+
+        while (getBegin (r) < getEnd (r))
+            if (range.compare_exchange_weak (r, pack (getBegin (r) + 1, getEnd (r)), std::memory_order_acq_rel))
+                return (int) getBegin (r);
+
+        return -1;
+    }
+
+    int stealChunk (int threadIndex, int numThreadsToSearch) noexcept
+    {
+        for (int i = 1; i < numThreadsToSearch; ++i)
+        {
+            auto& range = threads[(size_t) ((threadIndex + i) % numThreadsToSearch)].range;
+            auto r = range.load (std::memory_order_acquire);
+
+            while (getBegin (r) < getEnd (r))
+                if (range.compare_exchange_weak (r, pack (getBegin (r), getEnd (r) - 1), std::memory_order_acq_rel))
+                    return (int) getEnd (r) - 1;
+        }
+
+        return -1;
+    }
+
+    void processChunks (int threadIndex, int numThreadsToSearch)
+    {
+        auto& counts = threads[(size_t) threadIndex].curveCounts;
+
+        for (;;)
+        {
+            int chunk = takeOwnChunk (threadIndex);
+
+            if (chunk < 0)
+                chunk = stealChunk (threadIndex, numThreadsToSearch);
+
+            if (chunk < 0)
+                return;
+
+            const int start = chunk * chunkSize;
+            const int end = jmin (start + chunkSize, tickSize);
+
+            engine.advance (tickDelta, start, end);
+            engine.evaluateCurves (start, end, counts);
+
+            chunksRemaining.fetch_sub (1, std::memory_order_acq_rel);
+        }
+    }
+
+    //==============================================================================
+    AnimationEngine& engine;
+    const int numThreads;
+    std::unique_ptr<ThreadState[]> threads;
+    OwnedArray<Worker> workers;
+
+    double tickDelta = 0.0;
+    int tickSize = 0;
+    std::atomic<int> chunksRemaining { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (EvaluationPool)
+};
+
+//==============================================================================
+AnimationEngine::AnimationEngine (int frameRateHz)
+    : frameRate (jmax (1, frameRateHz))
+{
+    addEasing (EasingFunctions::EaseLinear());
+}
+
+AnimationEngine::~AnimationEngine()
+{
+    stopTimer();
+    background.reset();
+    evaluationPool.reset();
+}
+
+//==============================================================================
+AnimationEngine::AnimationId AnimationEngine::allocateId()
+{
+    AnimationId id;
+
+    if (freeSlots.isEmpty())
+    {
+        id.slot = slotGenerations.size();
+        slotGenerations.add (0);
+        slotToIndex.add (-1);
+        slotSchedules.add ({});
+    }
+    else
+    {
+        id.slot = freeSlots.getLast();
+        freeSlots.removeLast();
+    }
+
+    id.generation = ++slotGenerations.getReference (id.slot);
+    return id;
+}
+
+void AnimationEngine::releaseId (AnimationId id)
+{
+    ++slotGenerations.getReference (id.slot);
+    freeSlots.add (id.slot);
+
+    if (isPositiveAndBelow (id.slot, slotCallbacks.size()))
+        slotCallbacks.getReference (id.slot) = {};
+}
+
+bool AnimationEngine::isLive (AnimationId id) const noexcept
+{
+    return isPositiveAndBelow (id.slot, slotGenerations.size())
+            && slotGenerations.getUnchecked (id.slot) == id.generation;
+}
+
+int AnimationEngine::indexOf (AnimationId id) const noexcept
+{
+    if (! isPositiveAndBelow (id.slot, slotGenerations.size())
+         || slotGenerations.getUnchecked (id.slot) != id.generation)
+        return -1;
+
+    const int index = slotToIndex.getUnchecked (id.slot);
+
+    if (index < 0 || (state.flags.getUnchecked (index) & removedFlag) != 0)
+        return -1;
+
+    return index;
+}
+
+void AnimationEngine::reserve (int numAnimations)
+{
+    // in background mode the worker owns the state and the evaluation
+    // buffers, and may be writing to them now, so it grows them itself
+    if (background != nullptr)
+    {
+        BackgroundEvaluator::Command command { BackgroundEvaluator::Command::Type::reserve, {} };
+        command.capacity = numAnimations;
+        background->post (command);
+    }
+    else
+    {
+        reserveEvaluationStorage (numAnimations);
+    }
+
+    slotToIndex.ensureStorageAllocated (numAnimations);
+    slotGenerations.ensureStorageAllocated (numAnimations);
+    freeSlots.ensureStorageAllocated (numAnimations);
+    slotSchedules.ensureStorageAllocated (numAnimations);
+    pendingAnimations.ensureStorageAllocated (numAnimations);
+    slotCallbacks.ensureStorageAllocated (numAnimations);
+    frameIndexOfSlot.ensureStorageAllocated (numAnimations);
+}
+
+void AnimationEngine::reserveEvaluationStorage (int numAnimations)
+{
+    state.reserve (numAnimations);
+    order.ensureStorageAllocated (numAnimations);
+    scratchIn.ensureStorageAllocated (numAnimations);
+    scratchOut.ensureStorageAllocated (numAnimations);
+}
+
+AnimationEngine::AnimationId AnimationEngine::addAnimation (const Options& options)
+{
+    // the easing index must be one returned by addEasing()
+    jassert (isPositiveAndBelow (options.easing, curves.size()));
+
+    const auto id = allocateId();
+
+    auto& schedule = slotSchedules.getReference (id.slot);
+    schedule = {};
+    schedule.interval = options.maxUpdateRateHz > 0.0 ? 1.0 / options.maxUpdateRateHz : 0.0;
+    schedule.minValueChange = jmax (0.0, options.minValueChange);
+
+    if (background != nullptr)
+    {
+        BackgroundEvaluator::Command command { BackgroundEvaluator::Command::Type::add, id };
+        command.duration = options.duration;
+        command.startValue = options.startValue;
+        command.endValue = options.endValue;
+        command.loops = options.loops;
+        command.easing = isPositiveAndBelow (options.easing, curves.size()) ? options.easing : 0;
+        command.pingpong = options.pingpong;
+
+        slotCallbacks.resize (slotGenerations.size());
+        slotCallbacks.set (id.slot, { options.onUpdate, options.onFinished });
+
+        background->post (command);
+        startTimerIfNeeded();
+        return id;
+    }
+
+    if (isDispatching)
+    {
+        // adding to the state arrays now could move the callback that is
+        // currently being invoked, so this one has to wait for the dispatch
+        pendingAnimations.add ({ id, options });
+        return id;
+    }
+
+    slotToIndex.set (id.slot, state.size());
+    state.add (id, options);
+
+    if (! isPositiveAndBelow (options.easing, curves.size()))
+        state.easing.set (state.size() - 1, 0);
+
+    startTimerIfNeeded();
+    return id;
+}
+
+void AnimationEngine::removeAnimation (AnimationId id)
+{
+    if (background != nullptr)
+    {
+        if (isLive (id))
+        {
+            releaseId (id);
+            background->post ({ BackgroundEvaluator::Command::Type::remove, id });
+        }
+
+        return;
+    }
+
+    const int index = indexOf (id);
+
+    if (index < 0)
+    {
+        for (int i = pendingAnimations.size(); --i >= 0;)
+            if (pendingAnimations.getReference (i).id == id)
+                pendingAnimations.remove (i);
+
+        return;
+    }
+
+    if (isDispatching)
+        state.flags.getReference (index) |= removedFlag;
+    else
+        removeAt (index);
+}
+
+void AnimationEngine::removeAllAnimations()
+{
+    if (background != nullptr)
+    {
+        // allocateId() and releaseId() each bump the generation once, so a
+        // slot is in use exactly when its generation is odd
+        for (int slot = 0; slot < slotGenerations.size(); ++slot)
+        {
+            const auto generation = slotGenerations.getUnchecked (slot);
+
+            if ((generation & 1) != 0)
+                releaseId ({ slot, generation });
+        }
+
+        background->post ({ BackgroundEvaluator::Command::Type::removeAll, {} });
+        return;
+    }
+
+    pendingAnimations.clearQuick();
+
+    if (isDispatching)
+    {
+        for (auto& f : state.flags)
+            f |= removedFlag;
+
+        return;
+    }
+
+    for (int i = state.size(); --i >= 0;)
+        removeAt (i);
+}
+
+void AnimationEngine::removeAt (int index)
+{
+    const auto id = state.ids.getUnchecked (index);
+
+    slotToIndex.set (id.slot, -1);
+    releaseId (id);
+
+    state.removeAt (index);
+
+    if (index < state.size())
+        slotToIndex.set (state.ids.getUnchecked (index).slot, index);
+}
+
+void AnimationEngine::retarget (AnimationId id, double newEndValue)
+{
+    if (background != nullptr)
+    {
+        if (isLive (id))
+        {
+            BackgroundEvaluator::Command command { BackgroundEvaluator::Command::Type::retarget, id };
+            command.endValue = newEndValue;
+            background->post (command);
+        }
+
+        return;
+    }
+
+    const int index = indexOf (id);
+
+    if (index >= 0)
+        retargetAt (index, newEndValue);
+}
+
+void AnimationEngine::retargetAt (int index, double newEndValue) noexcept
+{
+    state.startValue.set (index, state.value.getUnchecked (index));
+    state.endValue.set (index, newEndValue);
+    state.elapsed.set (index, 0.0);
+    state.proportion.set (index, 0.0);
+    state.currentLoop.set (index, 0);
+    state.flags.getReference (index) &= (uint8) ~(reversedFlag | finishedFlag);
+}
+
+bool AnimationEngine::isAnimating (AnimationId id) const noexcept
+{
+    if (background != nullptr)
+        return isLive (id);
+
+    return indexOf (id) >= 0;
+}
+
+double AnimationEngine::getValue (AnimationId id) const noexcept
+{
+    if (background != nullptr)
+    {
+        const auto& frame = background->getFrontFrame();
+        const int index = isPositiveAndBelow (id.slot, frameIndexOfSlot.size()) ? frameIndexOfSlot.getUnchecked (id.slot) : -1;
+
+        // the slot may have been reused since the frame was evaluated
+        return (index >= 0 && frame.ids.getUnchecked (index) == id) ? frame.values.getUnchecked (index) : 0.0;
+    }
+
+    const int index = indexOf (id);
+    return index >= 0 ? state.value.getUnchecked (index) : 0.0;
+}
+
+int AnimationEngine::getNumAnimations() const noexcept
+{
+    if (background != nullptr)
+        return background->getFrontFrame().ids.size();
+
+    return state.size();
+}
+
+AnimationEngine::AnimationId AnimationEngine::getAnimationId (int index) const noexcept
+{
+    if (background != nullptr)
+        return background->getFrontFrame().ids[index];
+
+    return state.ids[index];
+}
+
+const double* AnimationEngine::getValues() const noexcept
+{
+    if (background != nullptr)
+        return background->getFrontFrame().values.getRawDataPointer();
+
+    return state.value.getRawDataPointer();
+}
+
+//==============================================================================
+void AnimationEngine::setEvaluation (Evaluation newEvaluation)
+{
+    // this can't be changed from inside one of the engine's own callbacks
+    jassert (! isDispatching);
+
+    if (newEvaluation == getEvaluation() || isDispatching)
+        return;
+
+    if (newEvaluation == Evaluation::backgroundThread)
+    {
+        // the callbacks stay on the message thread, indexed by slot
+        slotCallbacks.clearQuick();
+        slotCallbacks.resize (slotGenerations.size());
+
+        for (int i = 0; i < state.size(); ++i)
+        {
+            auto& callbacks = slotCallbacks.getReference (state.ids.getUnchecked (i).slot);
+            callbacks.onUpdate = std::move (state.onUpdate.getReference (i));
+            callbacks.onFinished = std::move (state.onFinished.getReference (i));
+        }
+
+        frameIndexOfSlot.clearQuick();
+        background = std::make_unique<BackgroundEvaluator> (*this);
+        return;
+    }
+
+    // deliver anything that finished before the worker stopped, then take
+    // back the state and the callbacks
+    background->stop();
+    dispatchBackgroundFrame();
+    background.reset();
+
+    for (int i = state.size(); --i >= 0;)
+        if (! isLive (state.ids.getUnchecked (i)))
+            state.removeAt (i);
+
+    slotToIndex.fill (-1);
+
+    for (int i = 0; i < state.size(); ++i)
+    {
+        const int slot = state.ids.getUnchecked (i).slot;
+        auto& callbacks = slotCallbacks.getReference (slot);
+
+        slotToIndex.set (slot, i);
+        state.onUpdate.set (i, std::move (callbacks.onUpdate));
+        state.onFinished.set (i, std::move (callbacks.onFinished));
+    }
+
+    slotCallbacks.clearQuick();
+    frameIndexOfSlot.clearQuick();
+}
+
+AnimationEngine::Evaluation AnimationEngine::getEvaluation() const noexcept
+{
+    return background != nullptr ? Evaluation::backgroundThread : Evaluation::messageThread;
+}
+
+int AnimationEngine::addCurve (std::unique_ptr<Curve> curve)
+{
+    auto* newCurve = curves.add (curve.release());
+
+    if (background != nullptr)
+    {
+        BackgroundEvaluator::Command command;
+        command.type = BackgroundEvaluator::Command::Type::addCurve;
+        command.curve = newCurve;
+        background->post (command);
+    }
+
+    return curves.size() - 1;
+}
+
+void AnimationEngine::setNumEvaluationThreads (int numThreads, int newMinAnimationsPerThread)
+{
+    if (numThreads <= 0)
+        numThreads = SystemStats::getNumCpus();
+
+    const ScopedLock sl (evaluationLock);
+
+    minAnimationsPerThread = jmax (EvaluationPool::chunkSize, newMinAnimationsPerThread);
+
+    if (numThreads == getNumEvaluationThreads())
+        return;
+
+    evaluationPool.reset();
+
+    if (numThreads > 1)
+        evaluationPool = std::make_unique<EvaluationPool> (*this, numThreads);
+}
+
+int AnimationEngine::getNumEvaluationThreads() const noexcept
+{
+    return evaluationPool != nullptr ? evaluationPool->getNumThreads() : 1;
+}
+
+//==============================================================================
+void AnimationEngine::setFrameRate (int newFrameRateHz)
+{
+    frameRate = jmax (1, newFrameRateHz);
+
+    if (isTimerRunning())
+        startTimerHz (frameRate);
+}
+
+void AnimationEngine::setTimerEnabled (bool shouldUseTimer)
+{
+    if (timerEnabled == shouldUseTimer)
+        return;
+
+    timerEnabled = shouldUseTimer;
+
+    if (! timerEnabled)
+        stopTimer();
+    else if (slotGenerations.size() != freeSlots.size())
+        startTimerIfNeeded();
+}
+
+void AnimationEngine::startTimerIfNeeded()
+{
+    if (! timerEnabled)
+        return;
+
+    const int frameIntervalMs = 1000 / frameRate;
+
+    if (! isTimerRunning())
+    {
+        lastTickTime = Time::getMillisecondCounterHiRes();
+        startTimer (frameIntervalMs);
+    }
+    else if (getTimerInterval() > frameIntervalMs)
+    {
+        // the timer has slowed down for rate-limited animations, but a new
+        // animation may need the next frame
+        startTimer (frameIntervalMs);
+    }
+}
+
+void AnimationEngine::timerCallback()
+{
+    const double now = Time::getMillisecondCounterHiRes();
+    const int intervalMs = getTimerInterval();
+    const double elapsed = jlimit (0.0, jmax (0.1, intervalMs / 500.0), (now - lastTickTime) / 1000.0);
+
+    timerIntervalMs = now - lastTickTime;
+    requestedIntervalMs = intervalMs;
+    lastTickTime = now;
+
+    tick (elapsed);
+
+    if (slotGenerations.size() == freeSlots.size())
+    {
+        stopTimer();
+        return;
+    }
+
+    // sleep until the next update that is due, but never beyond the frame rate
+    const int nextIntervalMs = jmax (1000 / frameRate, (int) std::ceil (getTimeUntilNextUpdate() * 1000.0));
+
+    if (nextIntervalMs != getTimerInterval())
+        startTimer (nextIntervalMs);
+}
+
+bool AnimationEngine::isUpdateDue (AnimationId id, double value) noexcept
+{
+    // a timer woken for a deadline may fire slightly early
+    constexpr double tolerance = 0.001;
+
+    auto& schedule = slotSchedules.getReference (id.slot);
+
+    if (schedule.interval > 0.0 && clockTime + tolerance < schedule.nextUpdateTime)
+        return false;
+
+    if (schedule.hasUpdated && std::abs (value - schedule.lastValue) < schedule.minValueChange)
+        return false;
+
+    // the next update is on the grid shared by every animation with this rate
+    if (schedule.interval > 0.0)
+        schedule.nextUpdateTime = (std::floor ((clockTime + tolerance) / schedule.interval) + 1.0) * schedule.interval;
+
+    schedule.lastValue = value;
+    schedule.hasUpdated = true;
+    return true;
+}
+
+double AnimationEngine::getTimeUntilNextUpdate() const noexcept
+{
+    const double frameInterval = 1.0 / frameRate;
+
+    // the worker's frames and animations waiting to be added need every tick
+    if (background != nullptr || ! pendingAnimations.isEmpty() || state.size() == 0)
+        return frameInterval;
+
+    double next = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < state.size(); ++i)
+    {
+        const auto& schedule = slotSchedules.getReference (state.ids.getUnchecked (i).slot);
+
+        if (schedule.interval <= 0.0)
+            return frameInterval;
+
+        // each pass still has to end on time, so that the animation finishes
+        // or loops when it should
+        const double untilEndOfPass = state.duration.getUnchecked (i) - state.elapsed.getUnchecked (i);
+        next = jmin (next, schedule.nextUpdateTime - clockTime, untilEndOfPass);
+    }
+
+    return jmax (frameInterval, next);
+}
+
+void AnimationEngine::tick (double deltaSeconds)
+{
+    // tick() can't be called from inside one of the engine's own callbacks
+    jassert (! isDispatching);
+
+    if (isDispatching)
+        return;
+
+    const AllocationCounter::Scope allocations;
+
+    clockTime += deltaSeconds;
+
+    if (statsEnabled)
+    {
+        currentStats.numFinishedAnimations = 0;
+        currentStats.numDroppedFrames = 0;
+        currentStats.slowestAnimation = {};
+        currentStats.slowestAnimationMs = 0.0;
+    }
+
+    int64 dispatchStartTicks;
+
+    if (background != nullptr)
+    {
+        // the worker starts on the next frame while this one is dispatched
+        background->requestFrame (deltaSeconds);
+        dispatchStartTicks = statsEnabled ? Time::getHighResolutionTicks() : 0;
+
+        if (dispatchBackgroundFrame())
+            currentStats.evaluationMs = background->getFrontFrame().evaluationMs;
+        else
+            ++currentStats.numDroppedFrames;
+    }
+    else
+    {
+        const auto startTicks = statsEnabled ? Time::getHighResolutionTicks() : 0;
+
+        evaluate (deltaSeconds, curves.getRawDataPointer(), curves.size());
+
+        dispatchStartTicks = statsEnabled ? Time::getHighResolutionTicks() : 0;
+        currentStats.evaluationMs = Time::highResolutionTicksToSeconds (dispatchStartTicks - startTicks) * 1000.0;
+
+        dispatch();
+    }
+
+    numAllocationsInLastTick = AllocationCounter::isEnabled() ? allocations.getNumAllocations() : -1;
+
+    if (statsEnabled)
+        publishStats (dispatchStartTicks);
+
+    timerIntervalMs = 0.0;
+    requestedIntervalMs = 0.0;
+}
+
+//==============================================================================
+void AnimationEngine::setStatsEnabled (bool shouldCollectStats)
+{
+    statsEnabled = shouldCollectStats;
+    currentStats = {};
+    publishedStats.store (currentStats);
+}
+
+AnimationEngine::Stats AnimationEngine::getStats() const noexcept
+{
+    return publishedStats.load();
+}
+
+template <typename Callback>
+void AnimationEngine::invokeCallback (AnimationId id, Callback&& callback)
+{
+    if (! statsEnabled)
+    {
+        callback();
+        return;
+    }
+
+    const auto startTicks = Time::getHighResolutionTicks();
+    callback();
+    const auto ms = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks) * 1000.0;
+
+    if (ms > currentStats.slowestAnimationMs)
+    {
+        currentStats.slowestAnimationMs = ms;
+        currentStats.slowestAnimation = id;
+    }
+}
+
+void AnimationEngine::publishStats (int64 dispatchStartTicks)
+{
+    auto& s = currentStats;
+
+    s.dispatchMs = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - dispatchStartTicks) * 1000.0;
+    s.numActiveAnimations = getNumAnimations();
+    s.timerJitterMs = 0.0;
+
+    if (timerIntervalMs > 0.0 && requestedIntervalMs > 0.0)
+    {
+        s.timerJitterMs = timerIntervalMs - requestedIntervalMs;
+        s.numDroppedFrames += jmax (0, roundToInt (timerIntervalMs / requestedIntervalMs) - 1);
+    }
+
+    ++s.numTicks;
+    s.totalFinishedAnimations += s.numFinishedAnimations;
+    s.totalDroppedFrames += s.numDroppedFrames;
+    s.maxTimerJitterMs = jmax (s.maxTimerJitterMs, s.timerJitterMs);
+
+    publishedStats.store (s);
+
+    const auto stats = s;
+    listeners.call ([this, &stats] (Listener& l) { l.animationEngineStatsUpdated (*this, stats); });
+}
+
+void AnimationEngine::PublishedStats::store (const Stats& s) noexcept
+{
+    // a seqlock: the sequence is odd while the fields are being written
+    const auto seq = sequence.load (std::memory_order_relaxed);
+    sequence.store (seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    numActiveAnimations.store (s.numActiveAnimations, std::memory_order_relaxed);
+    numFinishedAnimations.store (s.numFinishedAnimations, std::memory_order_relaxed);
+    numDroppedFrames.store (s.numDroppedFrames, std::memory_order_relaxed);
+    slowestSlot.store (s.slowestAnimation.slot, std::memory_order_relaxed);
+    slowestGeneration.store (s.slowestAnimation.generation, std::memory_order_relaxed);
+    evaluationMs.store (s.evaluationMs, std::memory_order_relaxed);
+    dispatchMs.store (s.dispatchMs, std::memory_order_relaxed);
+    slowestAnimationMs.store (s.slowestAnimationMs, std::memory_order_relaxed);
+    timerJitterMs.store (s.timerJitterMs, std::memory_order_relaxed);
+    maxTimerJitterMs.store (s.maxTimerJitterMs, std::memory_order_relaxed);
+    numTicks.store (s.numTicks, std::memory_order_relaxed);
+    totalFinishedAnimations.store (s.totalFinishedAnimations, std::memory_order_relaxed);
+    totalDroppedFrames.store (s.totalDroppedFrames, std::memory_order_relaxed);
+
+    sequence.store (seq + 2, std::memory_order_release);
+}
+
+AnimationEngine::Stats AnimationEngine::PublishedStats::load() const noexcept
+{
+    Stats s;
+
+    for (;;)
+    {
+        const auto seq = sequence.load (std::memory_order_acquire);
+
+        s.numActiveAnimations = numActiveAnimations.load (std::memory_order_relaxed);
+        s.numFinishedAnimations = numFinishedAnimations.load (std::memory_order_relaxed);
+        s.numDroppedFrames = numDroppedFrames.load (std::memory_order_relaxed);
+        s.slowestAnimation.slot = slowestSlot.load (std::memory_order_relaxed);
+        s.slowestAnimation.generation = slowestGeneration.load (std::memory_order_relaxed);
+        s.evaluationMs = evaluationMs.load (std::memory_order_relaxed);
+        s.dispatchMs = dispatchMs.load (std::memory_order_relaxed);
+        s.slowestAnimationMs = slowestAnimationMs.load (std::memory_order_relaxed);
+        s.timerJitterMs = timerJitterMs.load (std::memory_order_relaxed);
+        s.maxTimerJitterMs = maxTimerJitterMs.load (std::memory_order_relaxed);
+        s.numTicks = numTicks.load (std::memory_order_relaxed);
+        s.totalFinishedAnimations = totalFinishedAnimations.load (std::memory_order_relaxed);
+        s.totalDroppedFrames = totalDroppedFrames.load (std::memory_order_relaxed);
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        if ((seq & 1) == 0 && sequence.load (std::memory_order_relaxed) == seq)
+            return s;
+    }
+}
+
+//==============================================================================
+void AnimationEngine::evaluate (double deltaSeconds, Curve* const* curveList, int numCurves)
+{
+    evaluationCurves = curveList;
+    numEvaluationCurves = numCurves;
+
+    const int numAnimations = state.size();
+    const int numThreads = evaluationPool != nullptr ? jmin (evaluationPool->getNumThreads(),
+                                                              numAnimations / minAnimationsPerThread)
+                                                     : 1;
+
+    // sized up front, as the chunks share them
+    order.resize (numAnimations);
+    scratchIn.resize (numAnimations);
+    scratchOut.resize (numAnimations);
+
+    if (numThreads > 1)
+    {
+        evaluationPool->run (deltaSeconds, numAnimations, numThreads);
+        return;
+    }
+
+    advance (deltaSeconds, 0, numAnimations);
+    evaluateCurves (0, numAnimations, curveCounts);
+}
+
+void AnimationEngine::advance (double deltaSeconds, int start, int end) noexcept
+{
+    auto* elapsed     = state.elapsed.getRawDataPointer();
+    auto* duration    = state.duration.getRawDataPointer();
+    auto* proportion  = state.proportion.getRawDataPointer();
+    auto* loops       = state.loops.getRawDataPointer();
+    auto* currentLoop = state.currentLoop.getRawDataPointer();
+    auto* flags       = state.flags.getRawDataPointer();
+
+    for (int i = start; i < end; ++i)
+    {
+        const double d = duration[i];
+
+        if (d <= 0.0)
+        {
+            proportion[i] = 1.0;
+            flags[i] |= finishedFlag;
+            continue;
+        }
+
+        double e = elapsed[i] + deltaSeconds;
+
+        if (e >= d)
+        {
+            // one or more passes have completed during this tick
+            const double passes = std::floor (e / d);
+            const int remaining = loops[i] - currentLoop[i];
+
+            if (loops[i] == 0 || (loops[i] > 0 && passes > remaining))
+            {
+                // the passes before the last one still flip the direction
+                if ((flags[i] & pingpongFlag) != 0 && (remaining & 1) != 0)
+                    flags[i] ^= reversedFlag;
+
+                e = d;
+                flags[i] |= finishedFlag;
+            }
+            else
+            {
+                if (loops[i] > 0)
+                    currentLoop[i] += (int) passes;
+
+                if ((flags[i] & pingpongFlag) != 0 && std::fmod (passes, 2.0) != 0.0)
+                    flags[i] ^= reversedFlag;
+
+                e = jlimit (0.0, d, e - passes * d);
+            }
+        }
+
+        elapsed[i] = e;
+
+        const double p = e / d;
+        proportion[i] = (flags[i] & reversedFlag) != 0 ? 1.0 - p : p;
+    }
+}
+
+void AnimationEngine::evaluateCurves (int start, int end, PoolArray<int>& counts)
+{
+    const int numAnimations = end - start;
+
+    if (numAnimations <= 0)
+        return;
+
+    const int numCurves = numEvaluationCurves;
+    const auto* easing = state.easing.getRawDataPointer();
+    const auto* proportion = state.proportion.getRawDataPointer();
+    auto* eased = state.value.getRawDataPointer();
+
+    // Count the animations on each curve. If they're all on the same one (the
+    // common case) the proportions can be processed in place.
+    counts.resize (numCurves);
+    counts.fill (0);
+
+    for (int i = start; i < end; ++i)
+        ++counts.getReference (easing[i]);
+
+    const int onlyCurve = counts.indexOf (numAnimations);
+
+    if (onlyCurve >= 0)
+    {
+        evaluationCurves[onlyCurve]->process (proportion + start, eased + start, numAnimations);
+    }
+    else
+    {
+        // Otherwise, counting sort the animations by curve, gather their
+        // proportions into one block per curve and scatter the results back.
+        // The range only touches its own part of the scratch arrays.
+        auto* sorted = order.getRawDataPointer();
+        auto* input  = scratchIn.getRawDataPointer();
+        auto* output = scratchOut.getRawDataPointer();
+
+        int position = start;
+
+        for (auto& count : counts)
+        {
+            const int n = count;
+            count = position;
+            position += n;
+        }
+
+        for (int i = start; i < end; ++i)
+        {
+            const int p = counts.getReference (easing[i])++;
+            sorted[p] = i;
+            input[p] = proportion[i];
+        }
+
+        position = start;
+
+        for (int c = 0; c < numCurves; ++c)
+        {
+            const int curveEnd = counts.getUnchecked (c);
+
+            if (curveEnd > position)
+                evaluationCurves[c]->process (input + position, output + position, curveEnd - position);
+
+            position = curveEnd;
+        }
+
+        for (int i = start; i < end; ++i)
+            eased[sorted[i]] = output[i];
+    }
+
+    const auto* startValue = state.startValue.getRawDataPointer();
+    const auto* endValue   = state.endValue.getRawDataPointer();
+
+    for (int i = start; i < end; ++i)
+        eased[i] = startValue[i] + (endValue[i] - startValue[i]) * eased[i];
+}
+
+void AnimationEngine::dispatch()
+{
+    const int numAnimations = state.size();
+
+    isDispatching = true;
+
+    listeners.call ([this] (Listener& l) { l.animationEngineTicked (*this); });
+
+    for (int i = 0; i < numAnimations; ++i)
+    {
+        const auto f = state.flags.getUnchecked (i);
+
+        // the final value is always delivered, whatever the schedule says
+        if ((f & removedFlag) == 0 && state.onUpdate.getReference (i) != nullptr
+             && ((f & finishedFlag) != 0 || isUpdateDue (state.ids.getUnchecked (i), state.value.getUnchecked (i))))
+        {
+            invokeCallback (state.ids.getUnchecked (i),
+                            [this, i] { state.onUpdate.getReference (i) (state.value.getUnchecked (i)); });
+        }
+    }
+
+    for (int i = 0; i < numAnimations; ++i)
+    {
+        const auto f = state.flags.getUnchecked (i);
+
+        if ((f & finishedFlag) != 0 && (f & removedFlag) == 0)
+        {
+            const auto id = state.ids.getUnchecked (i);
+            ++currentStats.numFinishedAnimations;
+
+            if (state.onFinished.getReference (i) != nullptr)
+                invokeCallback (id, [this, i] { state.onFinished.getReference (i)(); });
+
+            listeners.call ([this, id] (Listener& l) { l.animationFinished (*this, id); });
+        }
+    }
+
+    isDispatching = false;
+
+    for (int i = state.size(); --i >= 0;)
+        if ((state.flags.getUnchecked (i) & (finishedFlag | removedFlag)) != 0)
+            removeAt (i);
+
+    for (auto& pending : pendingAnimations)
+    {
+        slotToIndex.set (pending.id.slot, state.size());
+        state.add (pending.id, pending.options);
+    }
+
+    pendingAnimations.clearQuick();
+
+    if (state.size() > 0)
+        startTimerIfNeeded();
+}
+
+bool AnimationEngine::dispatchBackgroundFrame()
+{
+    const bool hasNewFrame = background->acquireFrame();
+    const auto& frame = background->getFrontFrame();
+    const auto& finished = background->takeFinished();
+
+    if (hasNewFrame)
+    {
+        frameIndexOfSlot.resize (slotGenerations.size());
+        frameIndexOfSlot.fill (-1);
+
+        for (int i = 0; i < frame.ids.size(); ++i)
+            frameIndexOfSlot.set (frame.ids.getUnchecked (i).slot, i);
+    }
+
+    isDispatching = true;
+
+    if (hasNewFrame)
+    {
+        listeners.call ([this] (Listener& l) { l.animationEngineTicked (*this); });
+
+        for (int i = 0; i < frame.ids.size(); ++i)
+        {
+            const auto id = frame.ids.getUnchecked (i);
+
+            // animations removed since the frame was evaluated are skipped
+            if (isLive (id) && slotCallbacks.getReference (id.slot).onUpdate != nullptr
+                 && isUpdateDue (id, frame.values.getUnchecked (i)))
+            {
+                invokeCallback (id, [this, id, &frame, i]
+                {
+                    slotCallbacks.getReference (id.slot).onUpdate (frame.values.getUnchecked (i));
+                });
+            }
+        }
+    }
+
+    for (const auto& f : finished)
+    {
+        if (! isLive (f.id))
+            continue;
+
+        // moved out first, because the callbacks may start a new animation in the same slot
+        auto callbacks = std::move (slotCallbacks.getReference (f.id.slot));
+        releaseId (f.id);
+        ++currentStats.numFinishedAnimations;
+
+        const auto id = f.id;
+
+        invokeCallback (id, [&callbacks, &f]
+        {
+            if (callbacks.onUpdate != nullptr)
+                callbacks.onUpdate (f.value);
+
+            if (callbacks.onFinished != nullptr)
+                callbacks.onFinished();
+        });
+
+        listeners.call ([this, id] (Listener& l) { l.animationFinished (*this, id); });
+    }
+
+    isDispatching = false;
+    return hasNewFrame;
+}
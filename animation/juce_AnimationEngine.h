@@ -0,0 +1,532 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Runs any number of eased animations from a single timer.
+
+    Unlike AnimatedPosition<AnimatedPositionBehaviours::Eased<>>, which gives
+    every animation its own timer and heap object, the engine keeps the state
+    of all of its animations in contiguous arrays (one per field), advances
+    them all in a single pass on each tick, evaluates the easing curves in
+    blocks with EasingFunctions::processBlock(), and only then dispatches the
+    results to listeners and callbacks.
+
+    The timing follows the same rules as the Eased behaviour: an animation
+    plays once and then repeats `loops` more times (or forever if loops is
+    negative), optionally reversing on each repeat in ping-pong mode.
+
+    @code
+    AnimationEngine engine;
+    const auto bounce = engine.addEasing (EasingFunctions::EaseOutBounce());
+
+    AnimationEngine::Options options;
+    options.duration = 0.5;
+    options.endValue = 100.0;
+    options.easing   = bounce;
+    options.onUpdate = [this] (double v) { knob.setTopLeftPosition (0, (int) v); };
+
+    engine.addAnimation (options);
+    @endcode
+
+    By default everything happens on the message thread. With thousands of
+    animations, setEvaluation (Evaluation::backgroundThread) moves the timing
+    and curve evaluation to a worker thread, leaving only the callbacks on the
+    message thread.
+
+    The timer only runs while there are animations, and animations that don't
+    need every frame can say so with Options::maxUpdateRateHz and
+    Options::minValueChange. If every running animation is rate-limited, the
+    timer slows down to wake only for the next update that is due.
+
+    The engine is also a pool: the state of every animation, including its
+    callbacks, lives in arrays that only ever grow, and the callbacks are
+    stored inline rather than on the heap. Once reserve() has been called (or
+    the engine has warmed up to its peak number of animations), starting,
+    retargeting and removing animations and ticking the engine don't allocate.
+    Build with JUCE_ANIMATION_COUNT_ALLOCATIONS to check this with
+    getNumAllocationsInLastTick().
+
+    All methods must be called from the message thread.
+*/
+class AnimationEngine  : private Timer
+{
+public:
+    //==============================================================================
+    /** Creates an engine that ticks at the given rate while it has animations. */
+    explicit AnimationEngine (int frameRateHz = 60);
+
+    /** Destructor. */
+    ~AnimationEngine() override;
+
+    //==============================================================================
+    /** Identifies an animation running on the engine.
+
+        Ids are never reused, so an id that refers to an animation which has
+        finished or been removed is simply ignored by the engine.
+    */
+    struct AnimationId
+    {
+        int slot = -1;
+        uint32 generation = 0;
+
+        bool isValid() const noexcept                           { return slot >= 0; }
+        bool operator== (const AnimationId& other) const noexcept { return slot == other.slot && generation == other.generation; }
+        bool operator!= (const AnimationId& other) const noexcept { return ! operator== (other); }
+    };
+
+    /** The callback types used by Options. These hold their function inline,
+        so a lambda assigned to one mustn't capture more than 64 bytes.
+    */
+    using UpdateCallback   = InplaceFunction<void (double)>;
+    using FinishedCallback = InplaceFunction<void()>;
+
+    /** Describes an animation to be added with addAnimation(). */
+    struct Options
+    {
+        /** The duration of one pass of the animation in seconds. */
+        double duration = 0.0;
+
+        /** The number of additional passes. Negative values loop forever. */
+        int loops = 0;
+
+        /** Reverses the direction of each subsequent pass when looping. */
+        bool pingpong = false;
+
+        /** The values to animate between. */
+        double startValue = 0.0, endValue = 1.0;
+
+        /** An index returned by addEasing(). Zero is always a linear curve. */
+        int easing = 0;
+
+        /** The maximum rate at which onUpdate is called, or 0 to call it on
+            every tick. Updates are aligned to a grid shared by all animations
+            with the same rate, so that they happen on the same ticks.
+        */
+        double maxUpdateRateHz = 0.0;
+
+        /** The smallest change in value since the last call to onUpdate that
+            is worth calling it again for.
+        */
+        double minValueChange = 0.0;
+
+        /** Called with the new value after each tick, subject to
+            maxUpdateRateHz and minValueChange. It is always called with the
+            final value when the animation finishes.
+        */
+        UpdateCallback onUpdate;
+
+        /** Called once the animation has finished, just before it is removed. */
+        FinishedCallback onFinished;
+    };
+
+    //==============================================================================
+    /** Registers an easing curve with the engine and returns an index that can
+        be used in Options::easing. All animations using the same curve are
+        evaluated together in one block.
+    */
+    template <typename EasingType>
+    int addEasing (const EasingType& easing)
+    {
+        return addCurve (std::make_unique<TypedCurve<EasingType>> (easing));
+    }
+
+    /** Returns the number of registered easing curves. */
+    int getNumEasings() const noexcept                      { return curves.size(); }
+
+    //==============================================================================
+    /** Starts a new animation and returns its id. */
+    AnimationId addAnimation (const Options& options);
+
+    /** Preallocates space for a number of simultaneous animations, so that
+        running up to that many won't allocate. In background mode the
+        worker's share of the space is allocated on the worker, before it
+        evaluates its next frame.
+    */
+    void reserve (int numAnimations);
+
+    /** Stops and removes an animation without calling its onFinished callback. */
+    void removeAnimation (AnimationId id);
+
+    /** Stops and removes all animations. */
+    void removeAllAnimations();
+
+    /** Restarts an animation from its current value towards a new end value,
+        keeping its duration, easing, loops and callbacks. This is how values
+        coming from an AnimationUpdateQueue are usually applied.
+    */
+    void retarget (AnimationId id, double newEndValue);
+
+    /** Returns true if the id refers to an animation that is still running. */
+    bool isAnimating (AnimationId id) const noexcept;
+
+    /** Returns the most recent value of an animation, or 0 if it isn't running. */
+    double getValue (AnimationId id) const noexcept;
+
+    //==============================================================================
+    /** Returns the number of animations with a current value, i.e. the number
+        of values returned by getValues().
+    */
+    int getNumAnimations() const noexcept;
+
+    /** Returns the id of the animation at an index in [0, getNumAnimations()).
+        Indexes change whenever animations are removed, so only use this from a
+        listener callback.
+    */
+    AnimationId getAnimationId (int index) const noexcept;
+
+    /** Returns the current values of all running animations, in index order. */
+    const double* getValues() const noexcept;
+
+    //==============================================================================
+    /** Advances every animation by the given number of seconds, then notifies
+        listeners and callbacks.
+
+        This is called by the engine's timer, but can also be called directly to
+        drive the engine from some other clock.
+    */
+    void tick (double deltaSeconds);
+
+    /** Changes the rate at which the engine's timer ticks. */
+    void setFrameRate (int newFrameRateHz);
+
+    /** Returns the rate at which the engine's timer ticks. */
+    int getFrameRate() const noexcept                       { return frameRate; }
+
+    /** Turns the engine's timer on or off. While it's off, the engine only
+        moves when tick() is called, e.g. by a ManualAnimationClock.
+    */
+    void setTimerEnabled (bool shouldUseTimer);
+
+    /** Returns true unless the timer has been turned off with setTimerEnabled(). */
+    bool isTimerEnabled() const noexcept                    { return timerEnabled; }
+
+    /** Returns the number of heap allocations made on the message thread
+        during the last tick(), including any made by the callbacks and
+        listeners. Returns -1 unless the module is built with
+        JUCE_ANIMATION_COUNT_ALLOCATIONS.
+
+        @see AllocationCounter
+    */
+    int64 getNumAllocationsInLastTick() const noexcept      { return numAllocationsInLastTick; }
+
+    //==============================================================================
+    /** Where the animations are advanced and their curves evaluated. */
+    enum class Evaluation
+    {
+        /** Everything happens inside tick(), on the message thread. */
+        messageThread,
+
+        /** Each tick() hands its time step to a worker thread, which evaluates
+            the next frame while the message thread dispatches the most recent
+            finished one. Frames are passed back through a triple buffer, and
+            additions, removals, retargets and new easing curves are passed to
+            the worker as commands, so the message thread only ever waits for
+            the short moments when the worker is swapping lists, never for an
+            evaluation. The one exception is setNumEvaluationThreads(), which
+            waits for the frame being evaluated. The values seen by callbacks
+            and listeners are one frame behind the time step, and changes take
+            effect from the next frame.
+        */
+        backgroundThread
+    };
+
+    /** Changes where the animations are evaluated. Running animations carry
+        on across the change.
+    */
+    void setEvaluation (Evaluation newEvaluation);
+
+    /** Returns where the animations are evaluated. */
+    Evaluation getEvaluation() const noexcept;
+
+    /** Spreads the timing and curve evaluation of each tick over several
+        threads, for engines running tens of thousands of animations.
+
+        The animations are split into chunks of whole cache lines, which are
+        processed by a pool of worker threads kept for the life of the engine,
+        with the thread running the tick (the message thread, or the worker
+        in Evaluation::backgroundThread mode) joining in. Each thread starts
+        on its own contiguous run of chunks and then steals chunks from the
+        end of the others' runs, so a thread that gets held up doesn't hold up
+        the tick. Callbacks and listeners are still called from one thread.
+
+        Waking the workers costs some microseconds, so a tick only uses one
+        thread for every minAnimationsPerThread animations, and below twice
+        that it's evaluated on a single thread as before. In
+        Evaluation::backgroundThread mode, this waits for the frame being
+        evaluated to finish.
+
+        @param numThreads   the number of threads including the one running
+                            the tick, 0 for one per CPU core, or 1 to turn
+                            parallel evaluation off
+    */
+    void setNumEvaluationThreads (int numThreads, int minAnimationsPerThread = 16384);
+
+    /** Returns the number of threads that large ticks are spread over. */
+    int getNumEvaluationThreads() const noexcept;
+
+    //==============================================================================
+    /** Measurements of the work done by the engine, collected while stats are
+        enabled with setStatsEnabled().
+    */
+    struct Stats
+    {
+        /** The number of animations still running after the last tick. */
+        int numActiveAnimations = 0;
+
+        /** The number of animations that finished during the last tick. */
+        int numFinishedAnimations = 0;
+
+        /** The time spent advancing the animations and evaluating their curves
+            in the last tick. In background mode this is measured on the worker
+            thread, for the frame that was dispatched.
+        */
+        double evaluationMs = 0.0;
+
+        /** The time spent calling callbacks and listeners in the last tick. */
+        double dispatchMs = 0.0;
+
+        /** The animation whose callbacks took the longest in the last tick, and
+            how long they took.
+        */
+        AnimationId slowestAnimation;
+        double slowestAnimationMs = 0.0;
+
+        /** How much later (or earlier, if negative) the timer fired than the
+            interval requested by the frame rate. This is zero for ticks that
+            don't come from the engine's own timer.
+        */
+        double timerJitterMs = 0.0;
+
+        /** The number of frames that were missed before the last tick, either
+            because the timer fired late or, in background mode, because the
+            worker hadn't finished a new frame.
+        */
+        int numDroppedFrames = 0;
+
+        /** Totals since stats were enabled. */
+        int64 numTicks = 0;
+        int64 totalFinishedAnimations = 0;
+        int64 totalDroppedFrames = 0;
+        double maxTimerJitterMs = 0.0;
+    };
+
+    /** Turns the collection of stats on or off. Collecting them adds a few
+        clock reads per tick and one per callback, so it's cheap enough to leave
+        on in release builds. Enabling resets the totals.
+    */
+    void setStatsEnabled (bool shouldCollectStats);
+
+    /** Returns true if stats are being collected. */
+    bool areStatsEnabled() const noexcept                   { return statsEnabled; }
+
+    /** Returns the stats for the most recent tick. Unlike the other methods,
+        this can be called from any thread: the stats are published through
+        lock-free counters, and the snapshot returned is always from a single
+        tick.
+    */
+    Stats getStats() const noexcept;
+
+    //==============================================================================
+    /** Receives callbacks from an AnimationEngine. */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /** Called after each tick, once all values have been updated. The values
+            can be read in bulk with getValues().
+        */
+        virtual void animationEngineTicked (AnimationEngine&) = 0;
+
+        /** Called when an animation finishes, before it is removed. */
+        virtual void animationFinished (AnimationEngine&, AnimationId) {}
+
+        /** Called at the end of each tick while stats are enabled. */
+        virtual void animationEngineStatsUpdated (AnimationEngine&, const Stats&) {}
+    };
+
+    void addListener (Listener* listener)                   { listeners.add (listener); }
+    void removeListener (Listener* listener)                { listeners.remove (listener); }
+
+private:
+    //==============================================================================
+    struct Curve
+    {
+        virtual ~Curve() = default;
+        virtual void process (const double* input, double* output, int numValues) const noexcept = 0;
+    };
+
+    template <typename EasingType>
+    struct TypedCurve  : public Curve
+    {
+        explicit TypedCurve (const EasingType& e) : easing (e) {}
+
+        void process (const double* input, double* output, int numValues) const noexcept override
+        {
+            EasingFunctions::processBlock (easing, input, output, numValues);
+        }
+
+        EasingType easing;
+    };
+
+    //==============================================================================
+    // arrays that keep their storage when elements are removed
+    template <typename ElementType>
+    using PoolArray = Array<ElementType, DummyCriticalSection, std::numeric_limits<int>::max()>;
+
+    //==============================================================================
+    enum Flags : uint8
+    {
+        pingpongFlag = 1,
+        reversedFlag = 2,
+        finishedFlag = 4,
+        removedFlag  = 8
+    };
+
+    /** Per-animation state, stored as one array per field. */
+    struct State
+    {
+        int size() const noexcept       { return ids.size(); }
+        void reserve (int numAnimations);
+        void add (AnimationId id, const Options& options);
+        void removeAt (int index);
+
+        PoolArray<AnimationId> ids;
+        PoolArray<double> elapsed, duration, startValue, endValue, proportion, value;
+        PoolArray<int> loops, currentLoop, easing;
+        PoolArray<uint8> flags;
+        PoolArray<UpdateCallback> onUpdate;
+        PoolArray<FinishedCallback> onFinished;
+    };
+
+    //==============================================================================
+    class BackgroundEvaluator;
+    class EvaluationPool;
+
+    struct Callbacks
+    {
+        UpdateCallback onUpdate;
+        FinishedCallback onFinished;
+    };
+
+    /** When an animation's onUpdate is next due. */
+    struct UpdateSchedule
+    {
+        double interval = 0.0, minValueChange = 0.0;
+        double nextUpdateTime = 0.0, lastValue = 0.0;
+        bool hasUpdated = false;
+    };
+
+    /** The latest Stats, as atomics guarded by a sequence number so that
+        readers on other threads never see a mix of two ticks.
+    */
+    struct PublishedStats
+    {
+        void store (const Stats&) noexcept;
+        Stats load() const noexcept;
+
+        std::atomic<uint32> sequence { 0 };
+        std::atomic<int> numActiveAnimations { 0 }, numFinishedAnimations { 0 }, numDroppedFrames { 0 };
+        std::atomic<int> slowestSlot { -1 };
+        std::atomic<uint32> slowestGeneration { 0 };
+        std::atomic<double> evaluationMs { 0.0 }, dispatchMs { 0.0 }, slowestAnimationMs { 0.0 };
+        std::atomic<double> timerJitterMs { 0.0 }, maxTimerJitterMs { 0.0 };
+        std::atomic<int64> numTicks { 0 }, totalFinishedAnimations { 0 }, totalDroppedFrames { 0 };
+    };
+
+    //==============================================================================
+    void timerCallback() override;
+
+    int addCurve (std::unique_ptr<Curve> curve);
+    void reserveEvaluationStorage (int numAnimations);
+    void evaluate (double deltaSeconds, Curve* const* curveList, int numCurves);
+    void advance (double deltaSeconds, int start, int end) noexcept;
+    void evaluateCurves (int start, int end, PoolArray<int>& counts);
+    void dispatch();
+    bool dispatchBackgroundFrame();
+
+    AnimationId allocateId();
+    void releaseId (AnimationId id);
+    bool isLive (AnimationId id) const noexcept;
+    int indexOf (AnimationId id) const noexcept;
+    void removeAt (int index);
+    void retargetAt (int index, double newEndValue) noexcept;
+    void startTimerIfNeeded();
+    bool isUpdateDue (AnimationId id, double value) noexcept;
+    double getTimeUntilNextUpdate() const noexcept;
+
+    template <typename Callback>
+    void invokeCallback (AnimationId id, Callback&& callback);
+    void publishStats (int64 tickStartTicks);
+
+    //==============================================================================
+    State state;
+    OwnedArray<Curve> curves;
+
+    PoolArray<int> slotToIndex;
+    PoolArray<uint32> slotGenerations;
+    PoolArray<int> freeSlots;
+    PoolArray<UpdateSchedule> slotSchedules;
+
+    // like the state, these belong to the worker in background mode
+    PoolArray<int> curveCounts, order;
+    PoolArray<double> scratchIn, scratchOut;
+
+    // guarded by evaluationLock, as the background worker may be using it
+    CriticalSection evaluationLock;
+    std::unique_ptr<EvaluationPool> evaluationPool;
+    int minAnimationsPerThread = 16384;
+
+    // the curves used by the evaluation in progress
+    Curve* const* evaluationCurves = nullptr;
+    int numEvaluationCurves = 0;
+
+    struct PendingAnimation
+    {
+        AnimationId id;
+        Options options;
+    };
+
+    PoolArray<PendingAnimation> pendingAnimations;
+
+    ListenerList<Listener> listeners;
+
+    // only used in background mode, where the worker owns the state
+    std::unique_ptr<BackgroundEvaluator> background;
+    PoolArray<Callbacks> slotCallbacks;
+    PoolArray<int> frameIndexOfSlot;
+
+    int frameRate;
+    double lastTickTime = 0.0, clockTime = 0.0;
+    int64 numAllocationsInLastTick = -1;
+
+    bool statsEnabled = false;
+    Stats currentStats;
+    PublishedStats publishedStats;
+    double timerIntervalMs = 0.0, requestedIntervalMs = 0.0;
+    bool isDispatching = false, timerEnabled = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationEngine)
+};
@@ -0,0 +1,682 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+namespace
+{
+    namespace AnimationPresetFormat
+    {
+        struct HeaderRecord
+        {
+            char magic[4];
+            uint32 version, numPresets, numKeyframes, namesSize, reserved;
+        };
+
+        struct EasingRecord
+        {
+            uint32 type, reserved;
+            double parameters[4];
+        };
+
+        struct PresetRecord
+        {
+            uint32 nameOffset, kind;
+            int32 loops;
+            uint32 flags, firstKeyframe, numKeyframes;
+            double duration;
+            EasingRecord easing;
+        };
+
+        struct KeyframeRecord
+        {
+            double time, value;
+            EasingRecord easing;
+        };
+
+        static_assert (sizeof (HeaderRecord) == 24 && sizeof (EasingRecord) == 40
+                        && sizeof (PresetRecord) == 72 && sizeof (KeyframeRecord) == 56,
+                       "The records must have the same layout on every platform");
+
+        constexpr char magic[4] = { 'J', 'A', 'N', 'P' };
+        constexpr uint32 pingPongFlag = 1;
+
+        //==============================================================================
+        /** The names of the alternatives of AnyEasing::Variant, in order. */
+        const char* const easingNames[] =
+        {
+            "EaseLinear",
+            "EaseInQuad",    "EaseOutQuad",    "EaseInOutQuad",    "EaseOutInQuad",
+            "EaseInCubic",   "EaseOutCubic",   "EaseInOutCubic",   "EaseOutInCubic",
+            "EaseInQuart",   "EaseOutQuart",   "EaseInOutQuart",   "EaseOutInQuart",
+            "EaseInQuint",   "EaseOutQuint",   "EaseInOutQuint",   "EaseOutInQuint",
+            "EaseInSine",    "EaseOutSine",    "EaseInOutSine",    "EaseOutInSine",
+            "EaseInExpo",    "EaseOutExpo",    "EaseInOutExpo",    "EaseOutInExpo",
+            "EaseInCirc",    "EaseOutCirc",    "EaseInOutCirc",    "EaseOutInCirc",
+            "EaseInElastic", "EaseOutElastic", "EaseInOutElastic", "EaseOutInElastic",
+            "EaseInBack",    "EaseOutBack",    "EaseInOutBack",    "EaseOutInBack",
+            "EaseInBounce",  "EaseOutBounce",  "EaseInOutBounce",  "EaseOutInBounce",
+            "EaseCubicBezier"
+        };
+
+        using EasingVariant = EasingFunctions::AnyEasing::Variant;
+
+        static_assert (std::size (easingNames) == std::variant_size<EasingVariant>::value,
+                       "Every type of easing needs a name");
+
+        static_assert (std::size (EasingRecord().parameters) == (size_t) EasingFunctions::maxNumEasingParameters,
+                       "Every parameter of an easing needs to fit in a record");
+
+        struct ParameterNames
+        {
+            int num;
+            const char* names[4];
+        };
+
+        /** Reads and writes the parameters of one type of easing. */
+        template <typename EasingType>
+        struct EasingCodec
+        {
+            static constexpr bool isElastic = std::is_base_of<EasingFunctions::ElasticEasing, EasingType>::value;
+            static constexpr bool isBezier  = std::is_same<EasingFunctions::EaseCubicBezier, EasingType>::value;
+
+            static ParameterNames getNames() noexcept
+            {
+                if constexpr (isElastic)                                            return { 3, { "amplitude", "period", "fastApproximation" } };
+                else if constexpr (isBezier)                                        return { 4, { "x1", "y1", "x2", "y2" } };
+                else if constexpr (EasingFunctions::HasOvershoot<EasingType>::value) return { 1, { "overshoot" } };
+                else if constexpr (EasingFunctions::HasAmplitude<EasingType>::value) return { 1, { "amplitude" } };
+                else                                                                return { 0, {} };
+            }
+
+            static void getParameters (const EasingType& e, double* p) noexcept
+            {
+                EasingFunctions::getEasingParameters (e, p);
+            }
+
+            static void getDefaults (double* p) noexcept
+            {
+                getParameters (EasingType(), p);
+            }
+
+            static EasingFunctions::AnyEasing create (const double* p) noexcept
+            {
+                if constexpr (isElastic)
+                {
+                    EasingType e (p[0], p[1] > 0.0 ? p[1] : 1.0);
+                    e.setUseFastApproximation (p[2] != 0.0);
+                    return e;
+                }
+                else if constexpr (isBezier)
+                {
+                    return EasingType (jlimit (0.0, 1.0, p[0]), p[1], jlimit (0.0, 1.0, p[2]), p[3]);
+                }
+                else if constexpr (EasingFunctions::HasOvershoot<EasingType>::value)
+                {
+                    EasingType e;
+                    e.overshoot = p[0];
+                    return e;
+                }
+                else if constexpr (EasingFunctions::HasAmplitude<EasingType>::value)
+                {
+                    EasingType e;
+                    e.amplitude = p[0];
+                    return e;
+                }
+                else
+                {
+                    ignoreUnused (p);
+                    return EasingType();
+                }
+            }
+        };
+
+        struct EasingTypeInfo
+        {
+            const char* name;
+            ParameterNames (*getNames)() noexcept;
+            void (*getDefaults) (double*) noexcept;
+            EasingFunctions::AnyEasing (*create) (const double*) noexcept;
+        };
+
+        template <size_t... indices>
+        const EasingTypeInfo* getEasingTypes (std::index_sequence<indices...>)
+        {
+            static const EasingTypeInfo types[] =
+            {
+                { easingNames[indices],
+                  &EasingCodec<std::variant_alternative_t<indices, EasingVariant>>::getNames,
+                  &EasingCodec<std::variant_alternative_t<indices, EasingVariant>>::getDefaults,
+                  &EasingCodec<std::variant_alternative_t<indices, EasingVariant>>::create }...
+            };
+
+            return types;
+        }
+
+        constexpr int numEasingTypes = (int) std::variant_size<EasingVariant>::value;
+
+        /** Returns the codec for an index within AnyEasing::Variant. */
+        const EasingTypeInfo& getEasingType (int index)
+        {
+            static const auto* types = getEasingTypes (std::make_index_sequence<(size_t) numEasingTypes>());
+            return types[isPositiveAndBelow (index, numEasingTypes) ? index : 0];
+        }
+
+        EasingRecord encode (const EasingFunctions::AnyEasing& easing) noexcept
+        {
+            EasingRecord record {};
+            record.type = (uint32) easing.getTypeIndex();
+
+            easing.visit ([&record] (const auto& e)
+            {
+                EasingCodec<std::decay_t<decltype (e)>>::getParameters (e, record.parameters);
+            });
+
+            return record;
+        }
+
+        EasingFunctions::AnyEasing decode (const EasingRecord& record) noexcept
+        {
+            return getEasingType ((int) jmin (record.type, (uint32) numEasingTypes)).create (record.parameters);
+        }
+    }
+}
+
+//==============================================================================
+AnimationPresetLibrary::AnimationPresetLibrary() = default;
+
+AnimationPresetLibrary::AnimationPresetLibrary (const void* sourceData, size_t numBytes)
+{
+    open (sourceData, numBytes);
+}
+
+AnimationPresetLibrary::AnimationPresetLibrary (MemoryBlock&& sourceData)
+    : ownedData (std::move (sourceData))
+{
+    open (ownedData.getData(), ownedData.getSize());
+}
+
+AnimationPresetLibrary::AnimationPresetLibrary (const File& file)
+    : mappedFile (std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly))
+{
+    open (mappedFile->getData(), mappedFile->getSize());
+}
+
+AnimationPresetLibrary::~AnimationPresetLibrary() = default;
+
+void AnimationPresetLibrary::open (const void* sourceData, size_t numBytes)
+{
+    using namespace AnimationPresetFormat;
+
+   #if JUCE_BIG_ENDIAN
+    // the format is little-endian, and isn't converted when it's read
+    jassertfalse;
+    ignoreUnused (sourceData, numBytes);
+    return;
+   #endif
+
+    if (sourceData == nullptr || numBytes < sizeof (HeaderRecord))
+        return;
+
+    HeaderRecord header;
+    std::memcpy (&header, sourceData, sizeof (header));
+
+    if (std::memcmp (header.magic, magic, sizeof (magic)) != 0 || header.version != formatVersion)
+        return;
+
+    // the sizes are worked out in 64 bits, so that a corrupt header can't wrap
+    const auto presetsEnd   = (uint64) sizeof (HeaderRecord) + (uint64) header.numPresets * sizeof (PresetRecord);
+    const auto keyframesEnd = presetsEnd + (uint64) header.numKeyframes * sizeof (KeyframeRecord);
+    const auto namesEnd     = keyframesEnd + header.namesSize;
+
+    if (namesEnd > numBytes
+         || header.numPresets > (uint32) std::numeric_limits<int>::max()
+         || header.numKeyframes > (uint32) std::numeric_limits<int>::max())
+        return;
+
+    const auto* bytes = static_cast<const char*> (sourceData);
+
+    // every name must be terminated within the table
+    if (header.numPresets > 0 && (header.namesSize == 0 || bytes[namesEnd - 1] != 0))
+        return;
+
+    numPresets = (int) header.numPresets;
+    numKeyframes = (int) header.numKeyframes;
+    keyframesOffset = (size_t) presetsEnd;
+    namesOffset = (size_t) keyframesEnd;
+    namesSize = header.namesSize;
+    dataSize = numBytes;
+    data = bytes;
+}
+
+template <typename Record>
+Record AnimationPresetLibrary::readRecord (size_t offset) const noexcept
+{
+    jassert (offset + sizeof (Record) <= dataSize);
+
+    // copied out, because the data doesn't have to be aligned
+    Record record;
+    std::memcpy (&record, data + offset, sizeof (Record));
+    return record;
+}
+
+namespace
+{
+    size_t getPresetOffset (int index) noexcept
+    {
+        return sizeof (AnimationPresetFormat::HeaderRecord) + (size_t) index * sizeof (AnimationPresetFormat::PresetRecord);
+    }
+}
+
+//==============================================================================
+int AnimationPresetLibrary::indexOf (const char* nameUTF8) const noexcept
+{
+    if (nameUTF8 == nullptr)
+        return -1;
+
+    int low = 0, high = numPresets;
+
+    while (low < high)
+    {
+        const int mid = (low + high) / 2;
+        const int comparison = std::strcmp (getName (mid), nameUTF8);
+
+        if (comparison == 0)
+            return mid;
+
+        if (comparison < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return -1;
+}
+
+const char* AnimationPresetLibrary::getName (int index) const noexcept
+{
+    if (! isPositiveAndBelow (index, numPresets))
+        return "";
+
+    const auto offset = readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index)).nameOffset;
+    return offset < namesSize ? data + namesOffset + offset : "";
+}
+
+AnimationPresetLibrary::Kind AnimationPresetLibrary::getKind (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPresets));
+
+    if (! isPositiveAndBelow (index, numPresets))
+        return Kind::eased;
+
+    return readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index)).kind == 1 ? Kind::keyframes
+                                                                                         : Kind::eased;
+}
+
+double AnimationPresetLibrary::getDuration (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPresets));
+    return isPositiveAndBelow (index, numPresets) ? readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index)).duration : 0.0;
+}
+
+int AnimationPresetLibrary::getLoops (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPresets));
+    return isPositiveAndBelow (index, numPresets) ? (int) readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index)).loops : 0;
+}
+
+bool AnimationPresetLibrary::isPingPong (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPresets));
+    return isPositiveAndBelow (index, numPresets)
+            && (readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index)).flags & AnimationPresetFormat::pingPongFlag) != 0;
+}
+
+EasingFunctions::AnyEasing AnimationPresetLibrary::getEasing (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPresets));
+
+    if (! isPositiveAndBelow (index, numPresets))
+        return {};
+
+    return AnimationPresetFormat::decode (readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index)).easing);
+}
+
+int AnimationPresetLibrary::getNumKeyframes (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPresets));
+
+    if (! isPositiveAndBelow (index, numPresets))
+        return 0;
+
+    const auto preset = readRecord<AnimationPresetFormat::PresetRecord> (getPresetOffset (index));
+
+    // a corrupt range reads as an empty track
+    if ((uint64) preset.firstKeyframe + preset.numKeyframes > (uint64) numKeyframes)
+        return 0;
+
+    return (int) preset.numKeyframes;
+}
+
+KeyframeTrack<double>::Keyframe AnimationPresetLibrary::getKeyframe (int index, int keyframeIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (keyframeIndex, getNumKeyframes (index)));
+
+    if (! isPositiveAndBelow (keyframeIndex, getNumKeyframes (index)))
+        return {};
+
+    using namespace AnimationPresetFormat;
+
+    const auto first = (size_t) readRecord<PresetRecord> (getPresetOffset (index)).firstKeyframe;
+    const auto keyframe = readRecord<KeyframeRecord> (keyframesOffset + (first + (size_t) keyframeIndex) * sizeof (KeyframeRecord));
+
+    return { keyframe.time, keyframe.value, decode (keyframe.easing) };
+}
+
+bool AnimationPresetLibrary::applyTo (int index, KeyframeTrack<double>& track) const
+{
+    if (! isPositiveAndBelow (index, numPresets) || getKind (index) != Kind::keyframes)
+        return false;
+
+    const int num = getNumKeyframes (index);
+
+    track.clear();
+    track.ensureStorageAllocated (num);
+
+    for (int i = 0; i < num; ++i)
+    {
+        const auto keyframe = getKeyframe (index, i);
+        track.addKeyframe (keyframe.time, keyframe.value, keyframe.easing);
+    }
+
+    return true;
+}
+
+//==============================================================================
+#if JUCE_MODULE_AVAILABLE_juce_data_structures
+
+namespace
+{
+    namespace AnimationPresetIds
+    {
+        static const Identifier presets   ("AnimationPresets");
+        static const Identifier eased     ("Eased");
+        static const Identifier keyframes ("Keyframes");
+        static const Identifier keyframe  ("Keyframe");
+        static const Identifier name      ("name");
+        static const Identifier duration  ("duration");
+        static const Identifier loops     ("loops");
+        static const Identifier pingpong  ("pingpong");
+        static const Identifier easing    ("easing");
+        static const Identifier time      ("time");
+        static const Identifier value     ("value");
+    }
+
+    void writeEasing (ValueTree& tree, const EasingFunctions::AnyEasing& easing)
+    {
+        const auto record = AnimationPresetFormat::encode (easing);
+        const auto& type = AnimationPresetFormat::getEasingType ((int) record.type);
+        const auto names = type.getNames();
+
+        tree.setProperty (AnimationPresetIds::easing, type.name, nullptr);
+
+        for (int i = 0; i < names.num; ++i)
+            tree.setProperty (names.names[i], record.parameters[i], nullptr);
+    }
+
+    Result readEasing (const ValueTree& tree, EasingFunctions::AnyEasing& easing)
+    {
+        using namespace AnimationPresetFormat;
+
+        const auto typeName = tree.getProperty (AnimationPresetIds::easing, easingNames[0]).toString();
+
+        for (int i = 0; i < numEasingTypes; ++i)
+        {
+            const auto& type = getEasingType (i);
+
+            if (typeName == type.name)
+            {
+                double parameters[4] = {};
+                type.getDefaults (parameters);
+
+                const auto names = type.getNames();
+
+                for (int j = 0; j < names.num; ++j)
+                    parameters[j] = tree.getProperty (names.names[j], parameters[j]);
+
+                easing = type.create (parameters);
+                return Result::ok();
+            }
+        }
+
+        return Result::fail ("Unknown easing type: " + typeName);
+    }
+}
+
+ValueTree AnimationPresetLibrary::toValueTree() const
+{
+    ValueTree tree (AnimationPresetIds::presets);
+
+    for (int i = 0; i < numPresets; ++i)
+    {
+        const bool isKeyframes = getKind (i) == Kind::keyframes;
+        ValueTree preset (isKeyframes ? AnimationPresetIds::keyframes : AnimationPresetIds::eased);
+        preset.setProperty (AnimationPresetIds::name, String::fromUTF8 (getName (i)), nullptr);
+
+        if (isKeyframes)
+        {
+            for (int k = 0; k < getNumKeyframes (i); ++k)
+            {
+                const auto keyframe = getKeyframe (i, k);
+
+                ValueTree child (AnimationPresetIds::keyframe);
+                child.setProperty (AnimationPresetIds::time, keyframe.time, nullptr);
+                child.setProperty (AnimationPresetIds::value, keyframe.value, nullptr);
+                writeEasing (child, keyframe.easing);
+                preset.appendChild (child, nullptr);
+            }
+        }
+        else
+        {
+            preset.setProperty (AnimationPresetIds::duration, getDuration (i), nullptr);
+            preset.setProperty (AnimationPresetIds::loops, getLoops (i), nullptr);
+            preset.setProperty (AnimationPresetIds::pingpong, isPingPong (i), nullptr);
+            writeEasing (preset, getEasing (i));
+        }
+
+        tree.appendChild (preset, nullptr);
+    }
+
+    return tree;
+}
+
+#endif
+
+//==============================================================================
+AnimationPresetLibrary::Writer::Writer() = default;
+AnimationPresetLibrary::Writer::~Writer() = default;
+
+void AnimationPresetLibrary::Writer::addEased (const String& name, double duration, int loops, bool pingpong,
+                                               const EasingFunctions::AnyEasing& easing)
+{
+    Preset preset;
+    preset.kind = Kind::eased;
+    preset.duration = duration;
+    preset.loops = loops;
+    preset.pingpong = pingpong;
+    preset.easing = easing;
+
+    presets[name] = std::move (preset);
+}
+
+void AnimationPresetLibrary::Writer::addKeyframes (const String& name, const KeyframeTrack<double>& track)
+{
+    Preset preset;
+    preset.kind = Kind::keyframes;
+    preset.keyframes.ensureStorageAllocated (track.getNumKeyframes());
+
+    for (int i = 0; i < track.getNumKeyframes(); ++i)
+        preset.keyframes.add (track.getKeyframe (i));
+
+    presets[name] = std::move (preset);
+}
+
+#if JUCE_MODULE_AVAILABLE_juce_data_structures
+Result AnimationPresetLibrary::Writer::addFromValueTree (const ValueTree& tree)
+{
+    if (! tree.hasType (AnimationPresetIds::presets))
+        return Result::fail ("Expected a tree of type " + AnimationPresetIds::presets.toString());
+
+    for (int i = 0; i < tree.getNumChildren(); ++i)
+    {
+        const auto child = tree.getChild (i);
+        const auto name = child.getProperty (AnimationPresetIds::name).toString();
+
+        if (name.isEmpty())
+            return Result::fail ("Preset " + String (i) + " has no name");
+
+        if (child.hasType (AnimationPresetIds::eased))
+        {
+            EasingFunctions::AnyEasing easing;
+            const auto result = readEasing (child, easing);
+
+            if (! result.wasOk())
+                return result;
+
+            addEased (name,
+                      child.getProperty (AnimationPresetIds::duration, 0.0),
+                      child.getProperty (AnimationPresetIds::loops, 0),
+                      child.getProperty (AnimationPresetIds::pingpong, false),
+                      easing);
+        }
+        else if (child.hasType (AnimationPresetIds::keyframes))
+        {
+            KeyframeTrack<double> track;
+            track.ensureStorageAllocated (child.getNumChildren());
+
+            for (int k = 0; k < child.getNumChildren(); ++k)
+            {
+                const auto keyframe = child.getChild (k);
+                EasingFunctions::AnyEasing easing;
+                const auto result = readEasing (keyframe, easing);
+
+                if (! result.wasOk())
+                    return result;
+
+                track.addKeyframe (keyframe.getProperty (AnimationPresetIds::time, 0.0),
+                                   keyframe.getProperty (AnimationPresetIds::value, 0.0),
+                                   easing);
+            }
+
+            addKeyframes (name, track);
+        }
+        else
+        {
+            return Result::fail ("Unknown preset type: " + child.getType().toString());
+        }
+    }
+
+    return Result::ok();
+}
+#endif
+
+int AnimationPresetLibrary::Writer::getNumPresets() const noexcept
+{
+    return (int) presets.size();
+}
+
+MemoryBlock AnimationPresetLibrary::Writer::createData() const
+{
+    using namespace AnimationPresetFormat;
+
+    size_t totalKeyframes = 0, totalNameBytes = 0;
+
+    for (const auto& entry : presets)
+    {
+        totalKeyframes += (size_t) entry.second.keyframes.size();
+        totalNameBytes += std::strlen (entry.first.toRawUTF8()) + 1;
+    }
+
+    // keeps the size a multiple of 8, so that libraries can be concatenated
+    // or embedded without disturbing the alignment of whatever follows
+    const auto namesSize = (totalNameBytes + 7) & ~(size_t) 7;
+
+    jassert (presets.size() <= std::numeric_limits<uint32>::max()
+              && totalKeyframes <= std::numeric_limits<uint32>::max()
+              && namesSize <= std::numeric_limits<uint32>::max());
+
+    const auto presetsOffset   = sizeof (HeaderRecord);
+    const auto keyframesOffset = presetsOffset + presets.size() * sizeof (PresetRecord);
+    const auto namesOffset     = keyframesOffset + totalKeyframes * sizeof (KeyframeRecord);
+
+    MemoryBlock block (namesOffset + namesSize, true);
+    auto* dest = static_cast<char*> (block.getData());
+
+    HeaderRecord header {};
+    std::memcpy (header.magic, magic, sizeof (magic));
+    header.version = formatVersion;
+    header.numPresets = (uint32) presets.size();
+    header.numKeyframes = (uint32) totalKeyframes;
+    header.namesSize = (uint32) namesSize;
+    std::memcpy (dest, &header, sizeof (header));
+
+    size_t presetIndex = 0, keyframeIndex = 0, nameOffset = 0;
+
+    // std::map keeps the names in the byte order of their UTF-8, which is what
+    // indexOf() searches by
+    for (const auto& entry : presets)
+    {
+        const auto& source = entry.second;
+        const auto* name = entry.first.toRawUTF8();
+        const auto nameLength = std::strlen (name) + 1;
+
+        PresetRecord record {};
+        record.nameOffset = (uint32) nameOffset;
+        record.kind = source.kind == Kind::keyframes ? 1 : 0;
+        record.loops = (int32) source.loops;
+        record.flags = source.pingpong ? pingPongFlag : 0;
+        record.firstKeyframe = (uint32) keyframeIndex;
+        record.numKeyframes = (uint32) source.keyframes.size();
+        record.duration = source.duration;
+        record.easing = encode (source.easing);
+
+        std::memcpy (dest + presetsOffset + presetIndex++ * sizeof (PresetRecord), &record, sizeof (record));
+        std::memcpy (dest + namesOffset + nameOffset, name, nameLength);
+        nameOffset += nameLength;
+
+        for (const auto& keyframe : source.keyframes)
+        {
+            KeyframeRecord k {};
+            k.time = keyframe.time;
+            k.value = keyframe.value;
+            k.easing = encode (keyframe.easing);
+
+            std::memcpy (dest + keyframesOffset + keyframeIndex++ * sizeof (KeyframeRecord), &k, sizeof (k));
+        }
+    }
+
+    return block;
+}
+
+bool AnimationPresetLibrary::Writer::writeTo (OutputStream& stream) const
+{
+    const auto block = createData();
+    return stream.write (block.getData(), block.getSize());
+}
@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    A library of named animation presets, stored in a compact binary format
+    which is read in place.
+
+    Each preset is either the timing of an Eased animation (duration, loops,
+    ping-pong and easing curve, including the curve's parameters) or a
+    KeyframeTrack<double>. Presets are created with a Writer, usually from a
+    ValueTree that designers have edited, and the resulting data can be shipped
+    as a file or as binary data compiled into the app.
+
+    Loading a library only checks the header, and the presets are then read
+    directly from the data whenever they're used, so opening a library of
+    thousands of presets costs next to nothing and nothing is allocated per
+    preset. A library loaded from a File memory-maps it, so only the pages
+    that are actually used get read from disk. Looking up a preset by name is a
+    binary search.
+
+    @code
+    AnimationPresetLibrary presets (BinaryData::animations_bin, BinaryData::animations_binSize);
+
+    AnimatedPosition<AnimatedPositionBehaviours::Eased<EasingFunctions::AnyEasing>> pos;
+    presets.applyTo (presets.indexOf ("panelSlideIn"), pos.behaviour);
+    @endcode
+
+    The format is made of fixed-size little-endian records, with each field
+    aligned to its own size:
+
+    - a header: the characters "JANP", then the format version, the number of
+      presets, the number of keyframes, the size of the name table and a
+      reserved word, all as uint32
+    - one 72 byte record per preset, sorted by name
+    - one 56 byte record per keyframe, with each track's keyframes stored
+      together in time order
+    - the name table: each name as null-terminated UTF-8
+
+    Easing curves are stored as their index within AnyEasing::Variant and up to
+    four parameters.
+*/
+class AnimationPresetLibrary
+{
+public:
+    //==============================================================================
+    /** The kinds of preset that a library can hold. */
+    enum class Kind
+    {
+        eased,          /**< The timing of an AnimatedPositionBehaviours::Eased. */
+        keyframes       /**< A KeyframeTrack<double>. */
+    };
+
+    /** The version of the format written by Writer. */
+    static constexpr uint32 formatVersion = 1;
+
+    //==============================================================================
+    /** Creates an empty library. */
+    AnimationPresetLibrary();
+
+    /** Reads a library in place from a block of data, which must stay valid
+        and unchanged for as long as the library is used.
+    */
+    AnimationPresetLibrary (const void* data, size_t numBytes);
+
+    /** Reads a library from a block of data that the library takes over. */
+    explicit AnimationPresetLibrary (MemoryBlock&& data);
+
+    /** Memory-maps a library file and reads it in place. */
+    explicit AnimationPresetLibrary (const File& file);
+
+    /** Destructor. */
+    ~AnimationPresetLibrary();
+
+    /** Returns true if the data was a library this version can read. An
+        invalid library behaves as if it was empty.
+    */
+    bool isValid() const noexcept                       { return data != nullptr; }
+
+    //==============================================================================
+    /** Returns the number of presets. */
+    int getNumPresets() const noexcept                  { return numPresets; }
+
+    /** Returns the index of the preset with a given name, or -1 if there isn't
+        one. This doesn't allocate.
+    */
+    int indexOf (const char* nameUTF8) const noexcept;
+
+    /** Returns the index of the preset with a given name, or -1 if there isn't
+        one.
+    */
+    int indexOf (const String& name) const noexcept     { return indexOf (name.toRawUTF8()); }
+
+    /** Returns the name of a preset, as null-terminated UTF-8 held in the data.
+        The presets are sorted by name.
+    */
+    const char* getName (int index) const noexcept;
+
+    /** Returns what sort of preset this is. */
+    Kind getKind (int index) const noexcept;
+
+    //==============================================================================
+    /** Returns the duration of an eased preset, in seconds. */
+    double getDuration (int index) const noexcept;
+
+    /** Returns the loop count of an eased preset. */
+    int getLoops (int index) const noexcept;
+
+    /** Returns the ping-pong flag of an eased preset. */
+    bool isPingPong (int index) const noexcept;
+
+    /** Returns the easing curve of an eased preset. */
+    EasingFunctions::AnyEasing getEasing (int index) const noexcept;
+
+    /** Returns the number of keyframes in a keyframe preset. */
+    int getNumKeyframes (int index) const noexcept;
+
+    /** Returns one of the keyframes of a keyframe preset. */
+    KeyframeTrack<double>::Keyframe getKeyframe (int index, int keyframeIndex) const noexcept;
+
+    //==============================================================================
+    /** Sets the timing and easing of an Eased behaviour from an eased preset.
+
+        The behaviour's easing has to be able to hold the preset's curve: an
+        AnyEasing or std::function can hold any of them, but a behaviour using a
+        concrete type such as Eased<EaseOutCubic> can only take a preset with
+        that type of curve.
+
+        @returns false if the preset doesn't exist, isn't an eased preset, or
+                 has a curve that the behaviour can't hold
+    */
+    template <typename EasingFunction>
+    bool applyTo (int index, AnimatedPositionBehaviours::Eased<EasingFunction>& behaviour) const
+    {
+        if (! isPositiveAndBelow (index, numPresets) || getKind (index) != Kind::eased)
+            return false;
+
+        const auto easing = getEasing (index);
+
+        if constexpr (std::is_assignable<EasingFunction&, const EasingFunctions::AnyEasing&>::value)
+        {
+            behaviour.easing = easing;
+        }
+        else
+        {
+            const auto* curve = easing.template getIf<EasingFunction>();
+
+            if (curve == nullptr)
+                return false;
+
+            behaviour.easing = *curve;
+        }
+
+        behaviour.duration = getDuration (index);
+        behaviour.loops = getLoops (index);
+        behaviour.pingpong = isPingPong (index);
+        return true;
+    }
+
+    /** Replaces the keyframes of a track with those of a keyframe preset. This
+        only allocates if the track doesn't already have room for them.
+
+        @returns false if the preset doesn't exist or isn't a keyframe preset
+    */
+    bool applyTo (int index, KeyframeTrack<double>& track) const;
+
+   #if JUCE_MODULE_AVAILABLE_juce_data_structures
+    //==============================================================================
+    /** Converts the library to a ValueTree for editing, which Writer can turn
+        back into binary data.
+
+        The tree has the type "AnimationPresets". Each eased preset is an "Eased"
+        child with name, duration, loops, pingpong and easing properties, and each
+        keyframe preset is a "Keyframes" child with a name, holding "Keyframe"
+        children with time, value and easing properties. Easing curves are named
+        after their EasingFunctions types, e.g. "EaseOutBack", and their
+        parameters are extra properties such as "overshoot", or "x1", "y1", "x2"
+        and "y2" for a cubic Bezier.
+    */
+    ValueTree toValueTree() const;
+   #endif
+
+    //==============================================================================
+    /**
+        Collects presets and writes them in the binary format.
+
+        @code
+        AnimationPresetLibrary::Writer writer;
+        const auto result = writer.addFromValueTree (ValueTree::fromXml (designerXml));
+
+        FileOutputStream stream (outputFile);
+
+        if (result.wasOk() && stream.openedOk())
+            writer.writeTo (stream);
+        @endcode
+    */
+    class Writer
+    {
+    public:
+        Writer();
+        ~Writer();
+
+        /** Adds the timing of an Eased animation. A preset with the same name as
+            an earlier one replaces it.
+        */
+        void addEased (const String& name, double duration, int loops, bool pingpong,
+                       const EasingFunctions::AnyEasing& easing);
+
+        /** Adds the timing of an Eased behaviour whose easing is one of the
+            EasingFunctions types, or an AnyEasing.
+        */
+        template <typename EasingFunction>
+        void addEased (const String& name, const AnimatedPositionBehaviours::Eased<EasingFunction>& behaviour)
+        {
+            addEased (name, behaviour.duration, behaviour.loops, behaviour.pingpong,
+                      EasingFunctions::AnyEasing (behaviour.easing));
+        }
+
+        /** Adds the keyframes of a track. A preset with the same name as an earlier
+            one replaces it.
+        */
+        void addKeyframes (const String& name, const KeyframeTrack<double>& track);
+
+       #if JUCE_MODULE_AVAILABLE_juce_data_structures
+        /** Adds all the presets in a tree laid out as described for
+            AnimationPresetLibrary::toValueTree(). Presets are added until one
+            can't be read, whose problem is described by the result.
+        */
+        Result addFromValueTree (const ValueTree& tree);
+       #endif
+
+        /** Returns the number of presets added so far. */
+        int getNumPresets() const noexcept;
+
+        /** Returns the presets in the binary format. */
+        MemoryBlock createData() const;
+
+        /** Writes the presets in the binary format to a stream. */
+        bool writeTo (OutputStream& stream) const;
+
+    private:
+        struct Preset
+        {
+            Kind kind = Kind::eased;
+            double duration = 0.0;
+            int loops = 0;
+            bool pingpong = false;
+            EasingFunctions::AnyEasing easing;
+            Array<KeyframeTrack<double>::Keyframe> keyframes;
+        };
+
+        // keyed by name, which also keeps them in the order the library is searched in
+        std::map<String, Preset> presets;
+
+        JUCE_DECLARE_NON_COPYABLE (Writer)
+    };
+
+private:
+    //==============================================================================
+    void open (const void* data, size_t numBytes);
+
+    template <typename Record>
+    Record readRecord (size_t offset) const noexcept;
+
+    const char* data = nullptr;
+    size_t dataSize = 0;
+    int numPresets = 0, numKeyframes = 0;
+    size_t keyframesOffset = 0, namesOffset = 0, namesSize = 0;
+
+    MemoryBlock ownedData;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationPresetLibrary)
+};
@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+//==============================================================================
+double AnimationTimeline::Composition::getDuration() const noexcept
+{
+    return AnimationTimeline::flatten (*this, 0.0, nullptr);
+}
+
+AnimationTimeline::Composition AnimationTimeline::clip (int channel, double duration,
+                                                        double startValue, double endValue, int easing)
+{
+    jassert (channel >= 0);
+
+    Composition c;
+    c.type = Composition::Type::clip;
+    c.channel = jmax (0, channel);
+    c.duration = jmax (0.0, duration);
+    c.startValue = startValue;
+    c.endValue = endValue;
+    c.easing = easing;
+    return c;
+}
+
+AnimationTimeline::Composition AnimationTimeline::delay (double seconds)
+{
+    Composition c;
+    c.type = Composition::Type::delay;
+    c.duration = jmax (0.0, seconds);
+    return c;
+}
+
+AnimationTimeline::Composition AnimationTimeline::sequence (std::vector<Composition> children)
+{
+    Composition c;
+    c.type = Composition::Type::sequence;
+    c.children = std::move (children);
+    return c;
+}
+
+AnimationTimeline::Composition AnimationTimeline::parallel (std::vector<Composition> children)
+{
+    Composition c;
+    c.type = Composition::Type::parallel;
+    c.children = std::move (children);
+    return c;
+}
+
+AnimationTimeline::Composition AnimationTimeline::stagger (std::vector<Composition> children, double interval)
+{
+    Composition c;
+    c.type = Composition::Type::stagger;
+    c.children = std::move (children);
+    c.interval = jmax (0.0, interval);
+    return c;
+}
+
+AnimationTimeline::Composition AnimationTimeline::stagger (int firstChannel, int numChannels, double interval,
+                                                           double duration, double startValue, double endValue,
+                                                           int easing)
+{
+    auto c = clip (firstChannel, duration, startValue, endValue, easing);
+    c.type = Composition::Type::stagger;
+    c.numItems = jmax (0, numChannels);
+    c.interval = jmax (0.0, interval);
+    return c;
+}
+
+//==============================================================================
+double AnimationTimeline::flatten (const Composition& c, double offset, Array<Segment>* output)
+{
+    using Type = Composition::Type;
+
+    switch (c.type)
+    {
+        case Type::clip:
+            if (output != nullptr)
+                output->add ({ c.channel, offset, c.duration, c.startValue, c.endValue, c.easing });
+
+            return c.duration;
+
+        case Type::delay:
+            return c.duration;
+
+        case Type::sequence:
+        {
+            double t = offset;
+
+            for (const auto& child : c.children)
+                t += flatten (child, t, output);
+
+            return t - offset;
+        }
+
+        case Type::parallel:
+        {
+            double longest = 0.0;
+
+            for (const auto& child : c.children)
+                longest = jmax (longest, flatten (child, offset, output));
+
+            return longest;
+        }
+
+        case Type::stagger:
+        {
+            if (c.children.empty())
+            {
+                if (c.numItems == 0)
+                    return 0.0;
+
+                if (output != nullptr)
+                {
+                    output->ensureStorageAllocated (output->size() + c.numItems);
+
+                    for (int i = 0; i < c.numItems; ++i)
+                        output->add ({ c.channel + i, offset + i * c.interval, c.duration,
+                                       c.startValue, c.endValue, c.easing });
+                }
+
+                return (c.numItems - 1) * c.interval + c.duration;
+            }
+
+            double longest = 0.0;
+
+            for (size_t i = 0; i < c.children.size(); ++i)
+            {
+                const double start = (double) i * c.interval;
+                longest = jmax (longest, start + flatten (c.children[i], offset + start, output));
+            }
+
+            return longest;
+        }
+
+        default:
+            jassertfalse;
+            return 0.0;
+    }
+}
+
+//==============================================================================
+AnimationTimeline::AnimationTimeline()
+{
+    addEasing (EasingFunctions::EaseLinear());
+}
+
+AnimationTimeline::~AnimationTimeline() = default;
+
+int AnimationTimeline::addEasing (const EasingFunctions::AnyEasing& easing)
+{
+    easings.add (easing);
+    return easings.size() - 1;
+}
+
+void AnimationTimeline::setComposition (const Composition& composition)
+{
+    segments.clearQuick();
+    duration = flatten (composition, 0.0, &segments);
+
+    const int numSegments = segments.size();
+
+    // stable, so that segments starting together keep the composition's order
+    std::stable_sort (segments.begin(), segments.end(),
+                      [] (const Segment& a, const Segment& b) { return a.start < b.start; });
+
+    segmentStarts.clearQuick();
+    initialValues.clearQuick();
+
+    for (auto& s : segments)
+    {
+        // the easing index must be one returned by addEasing()
+        jassert (isPositiveAndBelow (s.easing, easings.size()));
+
+        if (! isPositiveAndBelow (s.easing, easings.size()))
+            s.easing = 0;
+
+        segmentStarts.add (s.start);
+
+        while (initialValues.size() <= s.channel)
+            initialValues.add (std::numeric_limits<double>::quiet_NaN());
+
+        if (std::isnan (initialValues.getUnchecked (s.channel)))
+            initialValues.set (s.channel, s.startValue);
+    }
+
+    // channels that no segment uses stay at zero
+    for (auto& v : initialValues)
+        if (std::isnan (v))
+            v = 0.0;
+
+    // counting sort by easing, which keeps each group in order of start time
+    const int numEasings = easings.size();
+    groupOffsets.resize (numEasings + 1);
+    groupOffsets.fill (0);
+
+    for (const auto& s : segments)
+        ++groupOffsets.getReference (s.easing + 1);
+
+    for (int e = 0; e < numEasings; ++e)
+        groupOffsets.getReference (e + 1) += groupOffsets.getUnchecked (e);
+
+    groupOrder.resize (numSegments);
+    groupStarts.resize (numSegments);
+
+    {
+        Array<int> next;
+        next.addArray (groupOffsets);
+
+        for (int i = 0; i < numSegments; ++i)
+        {
+            const int position = next.getReference (segments.getReference (i).easing)++;
+            groupOrder.set (position, i);
+            groupStarts.set (position, segments.getReference (i).start);
+        }
+    }
+
+    scratchIn.resize (numSegments);
+    scratchOut.resize (numSegments);
+    eased.resize (numSegments);
+    values.resize (initialValues.size());
+
+    evaluate (0.0);
+}
+
+//==============================================================================
+void AnimationTimeline::evaluate (double newTime) noexcept
+{
+    time = newTime;
+
+    // the segments that have started are a prefix of the schedule, and of
+    // each easing's group
+    const double* startsBegin = segmentStarts.begin();
+    const double* startsEnd = segmentStarts.end();
+    const int numStarted = (int) (std::upper_bound (startsBegin, startsEnd, time) - startsBegin);
+
+    const auto* s = segments.begin();
+    auto* in = scratchIn.getRawDataPointer();
+    auto* out = scratchOut.getRawDataPointer();
+
+    // groupOffsets only covers the easings that existed at the last
+    // setComposition(), and any added since then aren't used by a segment yet
+    for (int e = 0; e < groupOffsets.size() - 1; ++e)
+    {
+        const int begin = groupOffsets.getUnchecked (e);
+        const int end = groupOffsets.getUnchecked (e + 1);
+
+        const double* groupBegin = groupStarts.begin() + begin;
+        const double* groupEnd = groupStarts.begin() + end;
+        const int n = (int) (std::upper_bound (groupBegin, groupEnd, time) - groupBegin);
+
+        if (n == 0)
+            continue;
+
+        for (int i = begin; i < begin + n; ++i)
+        {
+            const auto& segment = s[groupOrder.getUnchecked (i)];
+            in[i] = segment.duration > 0.0 ? jmin (1.0, (time - segment.start) / segment.duration) : 1.0;
+        }
+
+        EasingFunctions::processBlock (easings.getReference (e), in + begin, out + begin, n);
+
+        for (int i = begin; i < begin + n; ++i)
+            eased.set (groupOrder.getUnchecked (i), out[i]);
+    }
+
+    auto* v = values.getRawDataPointer();
+    std::copy (initialValues.begin(), initialValues.end(), v);
+
+    for (int i = 0; i < numStarted; ++i)
+        v[s[i].channel] = s[i].startValue + (s[i].endValue - s[i].startValue) * eased.getUnchecked (i);
+}
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Plays a composition of animations from a single clock.
+
+    A composition is built from clips, each of which moves one numbered channel
+    between two values over a duration, combined with sequence(), parallel()
+    and stagger(). Setting the composition compiles it into one flat schedule:
+    an array of segments sorted by start time. Evaluating the timeline at a
+    time then works out every channel from that array, with no callbacks or
+    timers for the individual parts.
+
+    @code
+    AnimationTimeline timeline;
+    const auto outCubic = timeline.addEasing (EasingFunctions::EaseOutCubic());
+
+    using T = AnimationTimeline;
+    timeline.setComposition (T::sequence ({
+        T::clip (0, 0.3, 0.0, 1.0, outCubic),                  // fade in the header
+        T::parallel ({
+            T::clip (1, 0.5, -200.0, 0.0, outCubic),           // slide in the sidebar
+            T::stagger (2, 1000, 0.01, 0.25, 0.0, 1.0, outCubic)   // and the list rows
+        })
+    }));
+
+    // each frame
+    timeline.advance (deltaSeconds);
+    header.setAlpha ((float) timeline.getValue (0));
+    @endcode
+
+    Segments sharing an easing are evaluated together with
+    EasingFunctions::processBlock(), so a stagger over thousands of items costs
+    one block evaluation per frame. Evaluating never allocates.
+
+    Before a channel's first segment starts, the channel holds that segment's
+    start value. When two segments on the same channel overlap, the one that
+    started later wins.
+
+    A timeline can also be driven by an AnimationEngine, by animating the time
+    linearly from 0 to getDuration() and calling evaluate() from onUpdate.
+*/
+class AnimationTimeline
+{
+public:
+    //==============================================================================
+    /** One part of a composition. These are created with the static functions
+        of AnimationTimeline, and can be nested and copied freely.
+    */
+    class Composition
+    {
+    public:
+        /** Returns the total length of the composition in seconds. */
+        double getDuration() const noexcept;
+
+    private:
+        friend class AnimationTimeline;
+
+        enum class Type { clip, delay, sequence, parallel, stagger };
+
+        Type type = Type::delay;
+        int channel = 0, numItems = 0, easing = 0;
+        double duration = 0.0, startValue = 0.0, endValue = 0.0, interval = 0.0;
+        std::vector<Composition> children;
+    };
+
+    /** A channel moving between two values, starting at an offset from the
+        start of the timeline.
+    */
+    struct Segment
+    {
+        int channel;
+        double start, duration, startValue, endValue;
+        int easing;
+    };
+
+    //==============================================================================
+    /** Moves a channel from one value to another over a duration, using an
+        easing index returned by addEasing().
+    */
+    static Composition clip (int channel, double duration, double startValue, double endValue, int easing = 0);
+
+    /** Does nothing for a while. Use this inside a sequence. */
+    static Composition delay (double seconds);
+
+    /** Plays compositions one after another. */
+    static Composition sequence (std::vector<Composition> children);
+
+    /** Plays compositions at the same time. The result lasts as long as the
+        longest of them.
+    */
+    static Composition parallel (std::vector<Composition> children);
+
+    /** Plays compositions at the same time, each one starting a fixed interval
+        after the previous one.
+    */
+    static Composition stagger (std::vector<Composition> children, double interval);
+
+    /** Plays the same clip on a range of channels, each one starting a fixed
+        interval after the previous one. This is much cheaper to build than
+        staggering thousands of separate clips.
+    */
+    static Composition stagger (int firstChannel, int numChannels, double interval,
+                                double duration, double startValue, double endValue, int easing = 0);
+
+    //==============================================================================
+    /** Creates an empty timeline. */
+    AnimationTimeline();
+
+    /** Destructor. */
+    ~AnimationTimeline();
+
+    /** Registers an easing curve and returns the index to use for clips. Zero
+        is always a linear curve.
+    */
+    int addEasing (const EasingFunctions::AnyEasing& easing);
+
+    /** Compiles a composition into the timeline's schedule, replacing whatever
+        was there, and rewinds to the start.
+    */
+    void setComposition (const Composition& composition);
+
+    //==============================================================================
+    /** Returns the length of the timeline in seconds. */
+    double getDuration() const noexcept                 { return duration; }
+
+    /** Returns the number of channels, i.e. one more than the highest channel
+        used by the composition.
+    */
+    int getNumChannels() const noexcept                 { return initialValues.size(); }
+
+    /** Returns the number of segments in the schedule. */
+    int getNumSegments() const noexcept                 { return segments.size(); }
+
+    /** Returns a segment of the schedule, in order of start time. */
+    const Segment& getSegment (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, segments.size()));
+        return segments.getReference (index);
+    }
+
+    //==============================================================================
+    /** Moves the clock on by a number of seconds and evaluates the timeline. */
+    void advance (double deltaSeconds) noexcept         { evaluate (time + deltaSeconds); }
+
+    /** Moves the clock to a time in seconds and evaluates the timeline. */
+    void evaluate (double newTime) noexcept;
+
+    /** Returns the time at which the timeline was last evaluated. */
+    double getTime() const noexcept                     { return time; }
+
+    /** Returns true once the clock has passed the end of the timeline. */
+    bool isFinished() const noexcept                    { return time >= duration; }
+
+    /** Returns the value of a channel at the last evaluated time. */
+    double getValue (int channel) const noexcept        { return values[channel]; }
+
+    /** Returns the values of all channels at the last evaluated time. */
+    const double* getValues() const noexcept            { return values.getRawDataPointer(); }
+
+private:
+    //==============================================================================
+    static double flatten (const Composition&, double offset, Array<Segment>* output);
+
+    Array<EasingFunctions::AnyEasing> easings;
+
+    Array<Segment> segments;
+    Array<double> segmentStarts, initialValues, values;
+
+    // the segments grouped by easing, in order of start time within each group
+    Array<int> groupOrder, groupOffsets;
+    Array<double> groupStarts, scratchIn, scratchOut, eased;
+
+    double duration = 0.0, time = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationTimeline)
+};
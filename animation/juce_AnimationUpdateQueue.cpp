@@ -0,0 +1,73 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+AnimationUpdateQueue::AnimationUpdateQueue (int channels, int capacity)
+    : numChannels (channels),
+      fifo (jmax (2, capacity + 1)) // an AbstractFifo holds one less than its size
+{
+    jassert (numChannels > 0);
+
+    buffer.calloc ((size_t) fifo.getTotalSize());
+    latest.calloc ((size_t) numChannels);
+    changedChannels.calloc ((size_t) numChannels);
+    hasChanged.calloc ((size_t) numChannels);
+}
+
+AnimationUpdateQueue::~AnimationUpdateQueue() = default;
+
+int AnimationUpdateQueue::collectUpdates() noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+    int numChanged = 0;
+
+    auto collect = [&] (int start, int size)
+    {
+        for (int i = start; i < start + size; ++i)
+        {
+            const auto& update = buffer[(size_t) i];
+
+            if (! isPositiveAndBelow (update.channel, numChannels))
+                continue;
+
+            latest[(size_t) update.channel] = update;
+
+            if (! hasChanged[(size_t) update.channel])
+            {
+                hasChanged[(size_t) update.channel] = true;
+                changedChannels[(size_t) numChanged++] = update.channel;
+            }
+        }
+    };
+
+    collect (start1, size1);
+    collect (start2, size2);
+    fifo.finishedRead (size1 + size2);
+
+    std::sort (changedChannels.get(), changedChannels.get() + numChanged);
+
+    for (int i = 0; i < numChanged; ++i)
+        hasChanged[(size_t) changedChannels[(size_t) i]] = false;
+
+    return numChanged;
+}
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    A wait-free channel for sending animation targets from a realtime thread
+    (usually the audio thread) to the thread that runs the animations.
+
+    The producer thread calls pushUpdate() with a channel number, a target and
+    a velocity. This never locks or allocates, so it's safe to call from an
+    audio callback. The consumer thread calls drainUpdates() once per frame,
+    which collects everything that has been pushed since the last call and
+    invokes a callback once for each channel that changed, with only the
+    latest update for that channel. That way a meter fed from every audio
+    block is only retargeted once per frame.
+
+    @code
+    // in the processor
+    AnimationUpdateQueue levels { 2 };
+
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            levels.pushUpdate (ch, buffer.getRMSLevel (ch, 0, buffer.getNumSamples()));
+    }
+
+    // in the editor, once per frame
+    processor.levels.drainUpdates ([this] (int channel, double target, double velocity)
+    {
+        meters[channel].behaviour.retarget (meters[channel].getPosition(), target, velocity);
+    });
+    @endcode
+
+    There must only be one producer thread and one consumer thread.
+
+    @see AnimationEngine::retarget, AnimatedPositionBehaviours::Spring::retarget
+*/
+class AnimationUpdateQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue for a number of channels.
+
+        @param numChannels  the number of separate animations that can be
+                            addressed, numbered from 0
+        @param capacity     the number of updates that can be waiting between
+                            two calls to drainUpdates(). If the producer gets
+                            further ahead than this, updates are dropped.
+    */
+    explicit AnimationUpdateQueue (int numChannels, int capacity = 1024);
+
+    /** Destructor. */
+    ~AnimationUpdateQueue();
+
+    //==============================================================================
+    /** A target for one channel. */
+    struct Update
+    {
+        int channel;
+        double target;
+        double velocity;
+    };
+
+    /** Pushes a new target for a channel. This is wait-free and doesn't allocate.
+
+        Call this from the producer thread only. Returns false if the queue is
+        full, in which case the update is dropped and counted by
+        getNumDroppedUpdates().
+    */
+    bool pushUpdate (int channel, double target, double velocity = 0.0) noexcept
+    {
+        jassert (isPositiveAndBelow (channel, numChannels));
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+
+        if (size1 + size2 == 0)
+        {
+            numDropped.fetch_add (1, std::memory_order_relaxed);
+            return false;
+        }
+
+        buffer[size1 > 0 ? start1 : start2] = { channel, target, velocity };
+        fifo.finishedWrite (1);
+        return true;
+    }
+
+    //==============================================================================
+    /** Collects all the pending updates and calls a function with the latest
+        update for each channel that changed, in channel order:
+
+        @code
+        void (int channel, double target, double velocity)
+        @endcode
+
+        Call this from the consumer thread only. It doesn't allocate.
+
+        @returns the number of channels that were updated
+    */
+    template <typename Callback>
+    int drainUpdates (Callback&& callback)
+    {
+        const int numChanged = collectUpdates();
+
+        for (int i = 0; i < numChanged; ++i)
+        {
+            const auto& update = latest[(size_t) changedChannels[(size_t) i]];
+            callback (update.channel, update.target, update.velocity);
+        }
+
+        return numChanged;
+    }
+
+    /** Returns the number of channels. */
+    int getNumChannels() const noexcept                 { return numChannels; }
+
+    /** Returns the number of updates that were dropped because the queue was
+        full. This can be read from either thread.
+    */
+    int getNumDroppedUpdates() const noexcept           { return numDropped.load (std::memory_order_relaxed); }
+
+private:
+    //==============================================================================
+    int collectUpdates() noexcept;
+
+    const int numChannels;
+    AbstractFifo fifo;
+    HeapBlock<Update> buffer, latest;
+    HeapBlock<int> changedChannels;
+    HeapBlock<bool> hasChanged;
+    std::atomic<int> numDropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnimationUpdateQueue)
+};
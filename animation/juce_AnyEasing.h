@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace EasingFunctions
+{
+
+//==============================================================================
+/** Detects whether an easing type has an overshoot member, like the back family. */
+template <typename EasingType, typename = void>
+struct HasOvershoot  : std::false_type {};
+
+template <typename EasingType>
+struct HasOvershoot<EasingType, decltype ((void) std::declval<EasingType&>().overshoot)>  : std::true_type {};
+
+/** Detects whether an easing type has an amplitude member, like the bounce family. */
+template <typename EasingType, typename = void>
+struct HasAmplitude  : std::false_type {};
+
+template <typename EasingType>
+struct HasAmplitude<EasingType, decltype ((void) std::declval<EasingType&>().amplitude)>  : std::true_type {};
+
+/** The largest number of parameters of any of the easing types in this namespace. */
+constexpr int maxNumEasingParameters = 4;
+
+/** Writes the parameters of one of the easing types in this namespace to an
+    array of maxNumEasingParameters values, and returns how many it has.
+
+    The parameters are everything that the curve depends on, so two curves of
+    the same type with the same parameters always return the same values.
+    Types without parameters, or from outside this namespace, write nothing.
+*/
+template <typename EasingType>
+int getEasingParameters (const EasingType& easing, double* parameters) noexcept
+{
+    if constexpr (std::is_base_of<ElasticEasing, EasingType>::value)
+    {
+        parameters[0] = easing.getAmplitude();
+        parameters[1] = easing.getPeriod();
+        parameters[2] = easing.isUsingFastApproximation() ? 1.0 : 0.0;
+        return 3;
+    }
+    else if constexpr (std::is_same<EaseCubicBezier, EasingType>::value)
+    {
+        parameters[0] = easing.getX1();
+        parameters[1] = easing.getY1();
+        parameters[2] = easing.getX2();
+        parameters[3] = easing.getY2();
+        return 4;
+    }
+    else if constexpr (HasOvershoot<EasingType>::value)
+    {
+        parameters[0] = easing.overshoot;
+        return 1;
+    }
+    else if constexpr (HasAmplitude<EasingType>::value)
+    {
+        parameters[0] = easing.amplitude;
+        return 1;
+    }
+    else
+    {
+        ignoreUnused (easing, parameters);
+        return 0;
+    }
+}
+
+//==============================================================================
+/** Holds any one of the easing types in this namespace by value.
+
+    Like a std::function, the curve can be chosen at runtime, but an AnyEasing
+    never allocates and its parameters are stored inline, so it's a good fit
+    for containers of curves such as the keyframes of a KeyframeTrack.
+
+    @code
+    AnyEasing easing = EaseOutBounce();
+    easing = EaseInOutElastic (1.0, 0.4);
+
+    const double y = easing (0.25);
+    @endcode
+*/
+class AnyEasing
+{
+public:
+    using Variant = std::variant<EaseLinear,
+                                 EaseInQuad,    EaseOutQuad,    EaseInOutQuad,    EaseOutInQuad,
+                                 EaseInCubic,   EaseOutCubic,   EaseInOutCubic,   EaseOutInCubic,
+                                 EaseInQuart,   EaseOutQuart,   EaseInOutQuart,   EaseOutInQuart,
+                                 EaseInQuint,   EaseOutQuint,   EaseInOutQuint,   EaseOutInQuint,
+                                 EaseInSine,    EaseOutSine,    EaseInOutSine,    EaseOutInSine,
+                                 EaseInExpo,    EaseOutExpo,    EaseInOutExpo,    EaseOutInExpo,
+                                 EaseInCirc,    EaseOutCirc,    EaseInOutCirc,    EaseOutInCirc,
+                                 EaseInElastic, EaseOutElastic, EaseInOutElastic, EaseOutInElastic,
+                                 EaseInBack,    EaseOutBack,    EaseInOutBack,    EaseOutInBack,
+                                 EaseInBounce,  EaseOutBounce,  EaseInOutBounce,  EaseOutInBounce,
+                                 EaseCubicBezier>;
+
+    /** Creates a linear easing. */
+    AnyEasing() = default;
+
+    /** Creates an AnyEasing holding a copy of one of the easing types. */
+    template <typename EasingType,
+              typename = std::enable_if_t<! std::is_same<std::decay_t<EasingType>, AnyEasing>::value>>
+    AnyEasing (EasingType&& easing)
+        : curve (std::forward<EasingType> (easing))
+    {
+    }
+
+    /** Calls a function with the curve being held, as its concrete type. */
+    template <typename Visitor>
+    decltype (auto) visit (Visitor&& visitor) const
+    {
+        return std::visit (std::forward<Visitor> (visitor), curve);
+    }
+
+    /** Evaluates the curve. */
+    double operator() (double t) const noexcept
+    {
+        return visit ([t] (const auto& easing) { return easing (t); });
+    }
+
+    /** Returns the slope of the curve at t. */
+    double derivative (double t) const noexcept
+    {
+        return visit ([t] (const auto& easing) { return easing.derivative (t); });
+    }
+
+    /** Returns a pointer to the curve if it is of the given type, or nullptr. */
+    template <typename EasingType>
+    const EasingType* getIf() const noexcept        { return std::get_if<EasingType> (&curve); }
+
+    /** Returns the index of the type being held within Variant. */
+    int getTypeIndex() const noexcept               { return (int) curve.index(); }
+
+    /** Writes the parameters of the curve being held to an array of
+        maxNumEasingParameters values, and returns how many it has.
+
+        @see getEasingParameters
+    */
+    int getParameters (double* parameters) const noexcept;
+
+private:
+    Variant curve;
+};
+
+inline int AnyEasing::getParameters (double* parameters) const noexcept
+{
+    return visit ([parameters] (const auto& easing) { return getEasingParameters (easing, parameters); });
+}
+
+/** Detects whether an easing type is one of the types that AnyEasing can hold. */
+template <typename EasingType, typename Variant = AnyEasing::Variant>
+struct IsAnyEasingAlternative;
+
+template <typename EasingType, typename... Types>
+struct IsAnyEasingAlternative<EasingType, std::variant<Types...>>
+    : std::disjunction<std::is_same<EasingType, Types>...> {};
+
+//==============================================================================
+/** Processes a block with whichever curve the AnyEasing holds. The type is
+    only dispatched once per block, so this runs the same kernel as calling
+    processBlock() on the concrete type.
+*/
+inline void processBlock (const AnyEasing& easing, const double* input, double* output, int numValues) noexcept
+{
+    easing.visit ([=] (const auto& e) { processBlock (e, input, output, numValues); });
+}
+
+}
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+//==============================================================================
+template <typename ValueType>
+void ComponentPropertyAnimator::Track<ValueType>::start (const ValueType& from, const ValueType& to,
+                                                         const Timing& newTiming, FinishedCallback callback)
+{
+    timing = newTiming;
+    timing.seek (0.0);
+    value.setRange (from, to);
+    onFinished = std::move (callback);
+    elapsed = 0.0;
+    active = true;
+    finished = false;
+}
+
+template <typename ValueType>
+ValueType ComponentPropertyAnimator::Track<ValueType>::advance (double deltaSeconds) noexcept
+{
+    elapsed += deltaSeconds;
+    finished = timing.getPhaseAt (elapsed).finished;
+    return value.interpolate (timing.evaluateAt (elapsed));
+}
+
+//==============================================================================
+ComponentPropertyAnimator::ComponentPropertyAnimator (int frameRateHz)
+    : frameRate (jmax (1, frameRateHz))
+{
+}
+
+ComponentPropertyAnimator::~ComponentPropertyAnimator()
+{
+    stopTimer();
+}
+
+//==============================================================================
+ComponentPropertyAnimator::Target& ComponentPropertyAnimator::getTarget (Component& component)
+{
+    for (auto& target : targets)
+        if (target.component.getComponent() == &component)
+            return target;
+
+    Target target;
+    target.component = &component;
+    targets.add (target);
+
+    return targets.getReference (targets.size() - 1);
+}
+
+void ComponentPropertyAnimator::animateBounds (Component& component, Rectangle<int> targetBounds,
+                                               const Timing& timing, FinishedCallback onFinished)
+{
+    getTarget (component).bounds.start (component.getBounds(), targetBounds, timing, std::move (onFinished));
+    startTimerIfNeeded();
+}
+
+void ComponentPropertyAnimator::animateAlpha (Component& component, float targetAlpha,
+                                              const Timing& timing, FinishedCallback onFinished)
+{
+    getTarget (component).alpha.start (component.getAlpha(), targetAlpha, timing, std::move (onFinished));
+    startTimerIfNeeded();
+}
+
+void ComponentPropertyAnimator::animateTransform (Component& component, const AffineTransform& targetTransform,
+                                                  const Timing& timing, FinishedCallback onFinished)
+{
+    getTarget (component).transform.start (component.getTransform(), targetTransform, timing, std::move (onFinished));
+    startTimerIfNeeded();
+}
+
+//==============================================================================
+void ComponentPropertyAnimator::cancelAnimations (Component& component)
+{
+    for (int i = targets.size(); --i >= 0;)
+    {
+        auto& target = targets.getReference (i);
+
+        if (target.component.getComponent() == &component)
+        {
+            // while ticking, the entry is only deactivated so that the indexes
+            // being iterated don't move; it is removed at the end of the tick
+            target.bounds.active = target.alpha.active = target.transform.active = false;
+
+            if (! isTicking)
+                targets.remove (i);
+
+            return;
+        }
+    }
+}
+
+void ComponentPropertyAnimator::cancelAllAnimations()
+{
+    for (auto& target : targets)
+        target.bounds.active = target.alpha.active = target.transform.active = false;
+
+    if (! isTicking)
+        targets.clearQuick();
+}
+
+bool ComponentPropertyAnimator::isAnimating (const Component& component) const noexcept
+{
+    for (const auto& target : targets)
+        if (target.component.getComponent() == &component)
+            return target.isActive();
+
+    return false;
+}
+
+//==============================================================================
+void ComponentPropertyAnimator::setTimerEnabled (bool shouldUseTimer)
+{
+    if (timerEnabled == shouldUseTimer)
+        return;
+
+    timerEnabled = shouldUseTimer;
+
+    if (! timerEnabled)
+        stopTimer();
+    else if (! targets.isEmpty())
+        startTimerIfNeeded();
+}
+
+void ComponentPropertyAnimator::startTimerIfNeeded()
+{
+    if (timerEnabled && ! isTimerRunning())
+    {
+        lastTickTime = Time::getMillisecondCounterHiRes();
+        startTimerHz (frameRate);
+    }
+}
+
+void ComponentPropertyAnimator::timerCallback()
+{
+    const double now = Time::getMillisecondCounterHiRes();
+    const double elapsed = jlimit (0.0, 0.1, (now - lastTickTime) / 1000.0);
+    lastTickTime = now;
+
+    tick (elapsed);
+}
+
+void ComponentPropertyAnimator::tick (double deltaSeconds)
+{
+    // tick() can't be called from inside a setter or callback it has triggered
+    jassert (! isTicking);
+
+    if (isTicking)
+        return;
+
+    isTicking = true;
+
+    auto finishTrack = [this] (auto& track)
+    {
+        if (track.finished)
+        {
+            track.active = false;
+            finishedCallbacks.add (std::move (track.onFinished));
+        }
+    };
+
+    for (int i = 0; i < targets.size(); ++i)
+    {
+        auto& target = targets.getReference (i);
+        auto* component = target.component.getComponent();
+
+        if (component == nullptr)
+        {
+            target.bounds.active = target.alpha.active = target.transform.active = false;
+            continue;
+        }
+
+        // Work out every property first, then apply them together. The setters
+        // can call back into the animator (e.g. from resized()), which may add
+        // targets and move this one, so it mustn't be used after them.
+        const bool hasBounds = target.bounds.active;
+        const bool hasAlpha = target.alpha.active;
+        const bool hasTransform = target.transform.active;
+
+        const auto bounds    = hasBounds    ? target.bounds.advance (deltaSeconds)    : Rectangle<int>();
+        const auto alpha     = hasAlpha     ? target.alpha.advance (deltaSeconds)     : 1.0f;
+        const auto transform = hasTransform ? target.transform.advance (deltaSeconds) : AffineTransform();
+
+        if (hasBounds)     finishTrack (target.bounds);
+        if (hasAlpha)      finishTrack (target.alpha);
+        if (hasTransform)  finishTrack (target.transform);
+
+        if (hasBounds)     component->setBounds (bounds);
+        if (hasAlpha)      component->setAlpha (alpha);
+        if (hasTransform)  component->setTransform (transform);
+    }
+
+    for (int i = targets.size(); --i >= 0;)
+        if (! targets.getReference (i).isActive())
+            targets.remove (i);
+
+    isTicking = false;
+
+    for (int i = 0; i < finishedCallbacks.size(); ++i)
+        if (finishedCallbacks.getReference (i) != nullptr)
+            finishedCallbacks.getReference (i)();
+
+    finishedCallbacks.clearQuick();
+
+    if (targets.isEmpty())
+        stopTimer();
+}
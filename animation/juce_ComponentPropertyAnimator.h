@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Animates the bounds, alpha and transform of components, with every
+    animation advanced together from a single timer.
+
+    Each animation's timing and easing come from an Eased behaviour, so loops
+    and ping-pong work as they do for AnimatedPosition<Eased>. What differs is
+    how the results are applied. Once per frame every animation is evaluated,
+    and then each component gets at most one setBounds(), one setAlpha() and
+    one setTransform() call. So a panel sliding and resizing at the same time
+    is laid out once per frame, not once per property. Because all the changes
+    of a frame are made in the same callback, the regions they invalidate are
+    merged by the component peer and painted together, rather than the parent
+    being repainted each time a separate timer fires.
+
+    @code
+    ComponentPropertyAnimator::Timing timing;
+    timing.duration = 0.25;
+    timing.easing   = EasingFunctions::EaseOutCubic();
+
+    animator.animateBounds (panel, panel.getBounds().withX (0), timing);
+    animator.animateAlpha (panel, 1.0f, timing);
+    @endcode
+
+    Starting a new animation for a property that is already animating carries
+    on from the component's current value. Components that are deleted while
+    they are animating are simply dropped.
+
+    All methods must be called from the message thread.
+*/
+class ComponentPropertyAnimator  : private Timer
+{
+public:
+    //==============================================================================
+    /** Creates an animator that ticks at the given rate while it has animations. */
+    explicit ComponentPropertyAnimator (int frameRateHz = 60);
+
+    /** Destructor. Components are left wherever their animations had got to. */
+    ~ComponentPropertyAnimator() override;
+
+    //==============================================================================
+    /** The duration, loops, ping-pong mode and easing of an animation. */
+    using Timing = AnimatedPositionBehaviours::Eased<EasingFunctions::AnyEasing>;
+
+    /** Called when an animation reaches its end. */
+    using FinishedCallback = InplaceFunction<void()>;
+
+    /** Animates a component's bounds, relative to its parent. */
+    void animateBounds (Component& component, Rectangle<int> targetBounds,
+                        const Timing& timing, FinishedCallback onFinished = nullptr);
+
+    /** Animates a component's alpha. */
+    void animateAlpha (Component& component, float targetAlpha,
+                       const Timing& timing, FinishedCallback onFinished = nullptr);
+
+    /** Animates a component's transform. */
+    void animateTransform (Component& component, const AffineTransform& targetTransform,
+                           const Timing& timing, FinishedCallback onFinished = nullptr);
+
+    //==============================================================================
+    /** Stops all of a component's animations, leaving it as it is. */
+    void cancelAnimations (Component& component);
+
+    /** Stops all animations, leaving the components as they are. */
+    void cancelAllAnimations();
+
+    /** Returns true if any of a component's properties are animating. */
+    bool isAnimating (const Component& component) const noexcept;
+
+    /** Returns the number of components being animated. */
+    int getNumAnimatedComponents() const noexcept       { return targets.size(); }
+
+    //==============================================================================
+    /** Advances every animation by the given number of seconds and applies the
+        results. This is called by the animator's timer, but can also be called
+        directly to drive it from some other clock.
+    */
+    void tick (double deltaSeconds);
+
+    /** Turns the animator's timer on or off. While it's off, the animator only
+        moves when tick() is called, e.g. by a ManualAnimationClock.
+    */
+    void setTimerEnabled (bool shouldUseTimer);
+
+    /** Returns true unless the timer has been turned off with setTimerEnabled(). */
+    bool isTimerEnabled() const noexcept                { return timerEnabled; }
+
+private:
+    //==============================================================================
+    template <typename ValueType>
+    struct Track
+    {
+        bool isActive() const noexcept              { return active; }
+        void start (const ValueType& from, const ValueType& to, const Timing&, FinishedCallback);
+        ValueType advance (double deltaSeconds) noexcept;
+
+        Timing timing;
+        AnimatedValue<ValueType, EasingFunctions::EaseLinear> value;
+        FinishedCallback onFinished;
+        double elapsed = 0.0;
+        bool active = false, finished = false;
+    };
+
+    struct Target
+    {
+        bool isActive() const noexcept              { return bounds.active || alpha.active || transform.active; }
+
+        Component::SafePointer<Component> component;
+        Track<Rectangle<int>> bounds;
+        Track<float> alpha;
+        Track<AffineTransform> transform;
+    };
+
+    //==============================================================================
+    void timerCallback() override;
+
+    Target& getTarget (Component& component);
+    void startTimerIfNeeded();
+
+    //==============================================================================
+    Array<Target> targets;
+    Array<FinishedCallback> finishedCallbacks;
+
+    int frameRate;
+    double lastTickTime = 0.0;
+    bool isTicking = false, timerEnabled = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentPropertyAnimator)
+};
@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace EasingFunctions
+{
+
+//==============================================================================
+/** Versions of the maths functions needed by the transcendental easings that
+    can be evaluated at compile time, with the same interface as StandardMath.
+
+    They use range reduction followed by a series expansion, and are accurate
+    to within a few units in the last place over the ranges the easings use,
+    so they give the same curves as the C library to well below anything
+    visible. They are slower than the library calls at runtime, so they're
+    meant for building tables in constant expressions rather than for
+    evaluating curves on every frame.
+*/
+struct ConstexprMath
+{
+    /** Returns the absolute value of x. */
+    static constexpr double abs (double x) noexcept
+    {
+        return x < 0.0 ? -x : x;
+    }
+
+    /** Rounds to the nearest integer. x must be within the range of an int64. */
+    static constexpr double roundToNearest (double x) noexcept
+    {
+        x += 0.5;
+
+        const double truncated = (double) (int64) x;
+        return truncated > x ? truncated - 1.0 : truncated;
+    }
+
+    /** Returns the sine of x, which should be within +/- 1.0e6. */
+    static constexpr double sin (double x) noexcept
+    {
+        constexpr double pi    = juce::MathConstants<double>::pi;
+        constexpr double twoPi = juce::MathConstants<double>::twoPi;
+
+        x -= twoPi * roundToNearest (x / twoPi);
+
+        if (x > pi / 2.0)       x = pi - x;
+        else if (x < -pi / 2.0) x = -pi - x;
+
+        const double x2 = x * x;
+        double term = x, sum = x;
+
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -x2 / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    /** Returns the cosine of x, which should be within +/- 1.0e6. */
+    static constexpr double cos (double x) noexcept
+    {
+        return sin (x + juce::MathConstants<double>::halfPi);
+    }
+
+    /** Returns 2^x. Results too small for a double return 0, and results too
+        large for one return infinity.
+    */
+    static constexpr double exp2 (double x) noexcept
+    {
+        if (x < -1075.0) return 0.0;
+        if (x > 1024.0)  return std::numeric_limits<double>::infinity();
+
+        const double n = roundToNearest (x);
+        const double f = (x - n) * 0.69314718055994531;
+
+        double term = 1.0, sum = 1.0;
+
+        for (int i = 1; i < 18; ++i)
+        {
+            term *= f / i;
+            sum += term;
+        }
+
+        // scaling by powers of two is exact, so this only costs time
+        for (int i = 0; i < (int) n; ++i)   sum *= 2.0;
+        for (int i = 0; i < (int) -n; ++i)  sum *= 0.5;
+
+        return sum;
+    }
+
+    /** Returns the square root of x, or NaN if x is negative or NaN. */
+    static constexpr double sqrt (double x) noexcept
+    {
+        if (x != x)   return x;
+        if (x < 0.0)  return std::numeric_limits<double>::quiet_NaN();
+        if (x == 0.0 || x == std::numeric_limits<double>::infinity()) return x;
+
+        // Newton's method converges monotonically from any guess above the
+        // root, so it has converged as soon as the estimate stops shrinking
+        double estimate = x > 1.0 ? x : 1.0;
+
+        for (;;)
+        {
+            const double next = 0.5 * (estimate + x / estimate);
+
+            if (next >= estimate)
+                return estimate;
+
+            estimate = next;
+        }
+    }
+
+    /** Returns the arc tangent of x. */
+    static constexpr double atan (double x) noexcept
+    {
+        constexpr double pi = juce::MathConstants<double>::pi;
+
+        if (x < 0.0)  return -atan (-x);
+        if (x > 1.0)  return pi / 2.0 - atan (1.0 / x);
+
+        // tan (pi / 8): above this, shift the argument down by pi / 4 so that
+        // the series converges quickly
+        if (x > 0.41421356237309505)
+            return pi / 4.0 + atan ((x - 1.0) / (x + 1.0));
+
+        const double x2 = x * x;
+        double power = x, sum = x;
+
+        for (int n = 1; n < 24; ++n)
+        {
+            power *= -x2;
+            sum += power / (2 * n + 1);
+        }
+
+        return sum;
+    }
+
+    /** Returns the arc sine of x, which must be in [-1, 1]. */
+    static constexpr double asin (double x) noexcept
+    {
+        if (x >= 1.0)   return juce::MathConstants<double>::halfPi;
+        if (x <= -1.0)  return -juce::MathConstants<double>::halfPi;
+
+        return atan (x / sqrt (1.0 - x * x));
+    }
+};
+
+//==============================================================================
+/** Versions of the sine, exponential, circular and elastic easings which can
+    be evaluated at compile time, using the functions in ConstexprMath.
+
+    These are the same templates as the EasingFunctions types of the same name,
+    so they give the same curves to within 1.0e-15 (or that times the
+    amplitude, for the elastic curves). The polynomial, back and bounce easings
+    don't need a version here, because they are constexpr already.
+
+    @code
+    static constexpr auto table = makeStaticEasingTable<256> (Constexpr::EaseOutElastic (1.0, 0.3));
+    @endcode
+
+    @see makeStaticEasingTable, sampleEasingCurve
+*/
+namespace Constexpr
+{
+
+using EaseInSine       = BasicEaseInSine<ConstexprMath>;
+using EaseOutSine      = BasicEaseOutSine<ConstexprMath>;
+using EaseInOutSine    = BasicEaseInOutSine<ConstexprMath>;
+using EaseOutInSine    = BasicEaseOutInSine<ConstexprMath>;
+
+using EaseInExpo       = BasicEaseInExpo<ConstexprMath>;
+using EaseOutExpo      = BasicEaseOutExpo<ConstexprMath>;
+using EaseInOutExpo    = BasicEaseInOutExpo<ConstexprMath>;
+using EaseOutInExpo    = BasicEaseOutInExpo<ConstexprMath>;
+
+using EaseInCirc       = BasicEaseInCirc<ConstexprMath>;
+using EaseOutCirc      = BasicEaseOutCirc<ConstexprMath>;
+using EaseInOutCirc    = BasicEaseInOutCirc<ConstexprMath>;
+using EaseOutInCirc    = BasicEaseOutInCirc<ConstexprMath>;
+
+using ElasticEasing    = BasicElasticEasing<ConstexprMath>;
+using EaseInElastic    = BasicEaseInElastic<ConstexprMath>;
+using EaseOutElastic   = BasicEaseOutElastic<ConstexprMath>;
+using EaseInOutElastic = BasicEaseInOutElastic<ConstexprMath>;
+using EaseOutInElastic = BasicEaseOutInElastic<ConstexprMath>;
+
+} // namespace Constexpr
+
+}
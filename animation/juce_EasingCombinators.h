@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace EasingFunctions
+{
+
+//==============================================================================
+/** Combinators which build new curves out of the easing types, such as
+    Reverse<EaseInBack> or InOut<EaseCubicBezier>.
+
+    Each combinator holds the curves it is made from by value, and its
+    operator() calls them directly, so a composed curve is a single type that
+    the compiler can inline completely, rather than a chain of std::functions.
+    They are constexpr when the curves they hold are, so they can be sampled
+    with makeStaticEasingTable(), and processBlock() evaluates them with the
+    vectorised kernels of the curves they hold, where those have one.
+
+    Many of the built-in InOut and OutIn curves give the same values as these
+    to within rounding, e.g. EaseOutInCubic and OutIn<EaseInCubic>: both
+    variants of the Quad, Cubic, Quart, Quint and Circ curves, OutIn of Sine
+    and Back, and InOut of Elastic and Bounce. The rest are shaped
+    differently, so swapping one for the other changes the motion:
+    EaseInOutSine runs from 0 to -1, EaseInOutBack scales its overshoot by
+    1.525, EaseInOutExpo and EaseOutInExpo are rescaled to meet their end
+    points, and EaseOutInElastic and EaseOutInBounce join their halves
+    differently.
+
+    @code
+    // an overshooting curve which eases in for the first third, then out
+    constexpr Chain<EaseInBack, EaseOutCubic, std::ratio<1, 3>> curve;
+
+    // a bounce which falls back to the start
+    Mirror<EaseOutBounce> yoyo;
+
+    // an ease-out which arrives halfway through the time and then holds
+    TimeScale<EaseOutCubic, std::ratio<1, 2>> early;
+    @endcode
+*/
+
+//==============================================================================
+/** Plays a curve backwards in both time and value, which turns an ease-in
+    into the matching ease-out and vice versa: f(t) becomes 1 - f(1 - t).
+*/
+template <typename EasingType>
+struct Reverse
+{
+    constexpr Reverse() = default;
+
+    constexpr explicit Reverse (EasingType curveToReverse) noexcept
+        : curve (curveToReverse) {}
+
+    constexpr double operator() (double t) const noexcept
+    {
+        return 1.0 - curve (1.0 - t);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return getDerivative (curve, 1.0 - t);
+    }
+
+    EasingType curve {};
+};
+
+/** Plays a curve forwards over the first half of the time and backwards over
+    the second half, so it ends where it started.
+*/
+template <typename EasingType>
+struct Mirror
+{
+    constexpr Mirror() = default;
+
+    constexpr explicit Mirror (EasingType curveToMirror) noexcept
+        : curve (curveToMirror) {}
+
+    constexpr double operator() (double t) const noexcept
+    {
+        return curve (t < 0.5 ? t * 2.0 : (1.0 - t) * 2.0);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return t < 0.5 ? 2.0 * getDerivative (curve, t * 2.0)
+                       : -2.0 * getDerivative (curve, (1.0 - t) * 2.0);
+    }
+
+    EasingType curve {};
+};
+
+/** Plays one curve and then another.
+
+    The first curve covers times and values in [0, split), and the second covers
+    [split, 1], where split is a std::ratio strictly between 0 and 1.
+*/
+template <typename FirstEasingType, typename SecondEasingType, typename Split = std::ratio<1, 2>>
+struct Chain
+{
+    static constexpr double split = (double) Split::num / (double) Split::den;
+
+    static_assert (split > 0.0 && split < 1.0, "The split point must be between 0 and 1");
+
+    constexpr Chain() = default;
+
+    constexpr Chain (FirstEasingType firstCurve, SecondEasingType secondCurve) noexcept
+        : first (firstCurve), second (secondCurve) {}
+
+    constexpr double operator() (double t) const noexcept
+    {
+        if (t < split)
+            return split * first (t / split);
+
+        return split + (1.0 - split) * second ((t - split) / (1.0 - split));
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        if (t < split)
+            return getDerivative (first, t / split);
+
+        return getDerivative (second, (t - split) / (1.0 - split));
+    }
+
+    FirstEasingType first {};
+    SecondEasingType second {};
+};
+
+/** Plays a curve faster, over the first part of the time, and then holds its
+    end value: f(t) becomes curve (t / scale) until t reaches scale.
+
+    The scale is a std::ratio in (0, 1], so std::ratio<1, 2> plays the curve at
+    twice the speed, and it always finishes before the composed curve ends.
+*/
+template <typename EasingType, typename Scale>
+struct TimeScale
+{
+    static constexpr double scale = (double) Scale::num / (double) Scale::den;
+
+    static_assert (scale > 0.0 && scale <= 1.0, "The scale must be greater than 0 and no more than 1");
+
+    constexpr TimeScale() = default;
+
+    constexpr explicit TimeScale (EasingType curveToScale) noexcept
+        : curve (curveToScale) {}
+
+    constexpr double operator() (double t) const noexcept
+    {
+        return curve (t < scale ? t / scale : 1.0);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return t < scale ? getDerivative (curve, t / scale) / scale : 0.0;
+    }
+
+    EasingType curve {};
+};
+
+/** Eases in with a curve for the first half, then out with its reverse. */
+template <typename EasingType>
+struct InOut  : public Chain<EasingType, Reverse<EasingType>>
+{
+    constexpr InOut() = default;
+
+    constexpr explicit InOut (EasingType curve) noexcept
+        : Chain<EasingType, Reverse<EasingType>> (curve, Reverse<EasingType> (curve)) {}
+};
+
+/** Eases out with the reverse of a curve for the first half, then in with the
+    curve itself.
+*/
+template <typename EasingType>
+struct OutIn  : public Chain<Reverse<EasingType>, EasingType>
+{
+    constexpr OutIn() = default;
+
+    constexpr explicit OutIn (EasingType curve) noexcept
+        : Chain<Reverse<EasingType>, EasingType> (Reverse<EasingType> (curve), curve) {}
+};
+
+//==============================================================================
+namespace SIMDDetail
+{
+
+/** The kernels for the combinators are built from the kernels of the curves
+    they hold, so they are only vectorised if all of those curves are. The
+    apply() functions below are declared with trailing return types so that
+    they drop out of overload resolution when that isn't the case, which is
+    why the inner kernels are passed as defaulted template parameters.
+*/
+template <typename EasingType, typename = void>
+struct HasVectorisedKernel  : std::false_type {};
+
+template <typename EasingType>
+struct HasVectorisedKernel<EasingType,
+                           decltype ((void) BlockKernel<EasingType>::apply (std::declval<const EasingType&>(),
+                                                                            std::declval<ScalarRegister>()))>
+    : std::true_type {};
+
+/** A plain loop over operator(), for combinators of curves without kernels. */
+template <typename EasingType>
+struct ScalarKernel
+{
+    static void process (const EasingType& easing, const double* input,
+                         double* output, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            output[i] = easing (input[i]);
+    }
+};
+
+template <typename EasingType, typename Kernel, bool isVectorised>
+using CombinatorKernel = std::conditional_t<isVectorised,
+                                            VectorisedKernel<EasingType, Kernel>,
+                                            ScalarKernel<EasingType>>;
+
+//==============================================================================
+template <typename EasingType>
+struct BlockKernel<Reverse<EasingType>>
+    : CombinatorKernel<Reverse<EasingType>, BlockKernel<Reverse<EasingType>>,
+                       HasVectorisedKernel<EasingType>::value>
+{
+    template <typename Reg, typename Inner = BlockKernel<EasingType>>
+    static auto apply (const Reverse<EasingType>& e, Reg t) noexcept
+        -> decltype (Inner::apply (e.curve, t))
+    {
+        return Reg (1.0) - Inner::apply (e.curve, Reg (1.0) - t);
+    }
+};
+
+template <typename EasingType>
+struct BlockKernel<Mirror<EasingType>>
+    : CombinatorKernel<Mirror<EasingType>, BlockKernel<Mirror<EasingType>>,
+                       HasVectorisedKernel<EasingType>::value>
+{
+    template <typename Reg, typename Inner = BlockKernel<EasingType>>
+    static auto apply (const Mirror<EasingType>& e, Reg t) noexcept
+        -> decltype (Inner::apply (e.curve, t))
+    {
+        return Inner::apply (e.curve, select (t < 0.5, t * 2.0, (Reg (1.0) - t) * 2.0));
+    }
+};
+
+template <typename FirstEasingType, typename SecondEasingType, typename Split>
+struct BlockKernel<Chain<FirstEasingType, SecondEasingType, Split>>
+    : CombinatorKernel<Chain<FirstEasingType, SecondEasingType, Split>,
+                       BlockKernel<Chain<FirstEasingType, SecondEasingType, Split>>,
+                       HasVectorisedKernel<FirstEasingType>::value && HasVectorisedKernel<SecondEasingType>::value>
+{
+    using Curve = Chain<FirstEasingType, SecondEasingType, Split>;
+
+    template <typename Reg,
+              typename FirstKernel = BlockKernel<FirstEasingType>,
+              typename SecondKernel = BlockKernel<SecondEasingType>>
+    static auto apply (const Curve& e, Reg t) noexcept
+        -> decltype (FirstKernel::apply (e.first, t), SecondKernel::apply (e.second, t))
+    {
+        constexpr double split = Curve::split;
+
+        // both halves are evaluated for every value, and then the right one is
+        // picked, which is cheaper than branching when the curves are simple
+        const Reg lo = Reg (split) * FirstKernel::apply (e.first, t / split);
+        const Reg hi = Reg (split) + Reg (1.0 - split)
+                                     * SecondKernel::apply (e.second, (t - split) / Reg (1.0 - split));
+
+        return select (t < split, lo, hi);
+    }
+};
+
+template <typename EasingType, typename Scale>
+struct BlockKernel<TimeScale<EasingType, Scale>>
+    : CombinatorKernel<TimeScale<EasingType, Scale>, BlockKernel<TimeScale<EasingType, Scale>>,
+                       HasVectorisedKernel<EasingType>::value>
+{
+    template <typename Reg, typename Inner = BlockKernel<EasingType>>
+    static auto apply (const TimeScale<EasingType, Scale>& e, Reg t) noexcept
+        -> decltype (Inner::apply (e.curve, t))
+    {
+        constexpr double scale = TimeScale<EasingType, Scale>::scale;
+
+        return Inner::apply (e.curve, select (t < scale, t / scale, Reg (1.0)));
+    }
+};
+
+template <typename EasingType>
+struct BlockKernel<InOut<EasingType>>  : BlockKernel<Chain<EasingType, Reverse<EasingType>>> {};
+
+template <typename EasingType>
+struct BlockKernel<OutIn<EasingType>>  : BlockKernel<Chain<Reverse<EasingType>, EasingType>> {};
+
+} // namespace SIMDDetail
+
+}
@@ -30,10 +30,15 @@ namespace EasingFunctions
 */
 struct EaseLinear
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return t;
     }
+
+    constexpr double derivative (double) const noexcept
+    {
+        return 1.0;
+    }
 };
 
 // =============================================================================
@@ -42,27 +47,37 @@ struct EaseLinear
 */
 struct EaseInQuad
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return t * t;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return 2.0 * t;
+    }
 };
 
 /** Quadratic easing (t^2): decelerating to zero
 */
 struct EaseOutQuad
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return -t * (t - 2.0);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return 2.0 - 2.0 * t;
+    }
 };
 
 /** Quadratic easing (t^2): acceleration halfway, then deceleration
 */
 struct EaseInOutQuad
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t *= 2.0;
         if (t < 1.0) return t * t / 2.0;
@@ -70,13 +85,22 @@ struct EaseInOutQuad
         --t;
         return -0.5 * (t * (t - 2.0) - 1.0);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t *= 2.0;
+        if (t < 1.0) return 2.0 * t;
+
+        --t;
+        return 2.0 * (1.0 - t);
+    }
 };
 
 /** Quadratic easing (t^2): deceleration halfway, then acceleration
 */
 struct EaseOutInQuad
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -87,6 +111,14 @@ struct EaseOutInQuad
         t = 2.0 * t - 1.0;
         return (t * t) / 2.0 + 0.5;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        if (t < 0.5)
+            return 2.0 * (1.0 - 2.0 * t);
+
+        return 2.0 * (2.0 * t - 1.0);
+    }
 };
 
 // =============================================================================
@@ -95,28 +127,39 @@ struct EaseOutInQuad
 */
 struct EaseInCubic
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return t * t * t;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return 3.0 * t * t;
+    }
 };
 
 /** Cubic easing (t^3): decelerating to zero
 */
 struct EaseOutCubic
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t -= 1.0;
         return t * t * t + 1.0;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t -= 1.0;
+        return 3.0 * t * t;
+    }
 };
 
 /** Cubic easing (t^3): acceleration halfway, then deceleration
 */
 struct EaseInOutCubic
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t *= 2.0;
         if (t < 1.0) return 0.5 * t * t * t;
@@ -124,13 +167,21 @@ struct EaseInOutCubic
         t -= 2.0;
         return 0.5 * (t * t * t + 2.0);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t *= 2.0;
+        if (t >= 1.0) t -= 2.0;
+
+        return 3.0 * t * t;
+    }
 };
 
 /** Cubic easing (t^3): deceleration halfway, then acceleration
 */
 struct EaseOutInCubic
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -141,6 +192,12 @@ struct EaseOutInCubic
         t = 2.0 * t - 1.0;
         return (t * t * t) / 2.0 + 0.5;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t = 2.0 * t - 1.0;
+        return 3.0 * t * t;
+    }
 };
 
 // =============================================================================
@@ -149,28 +206,39 @@ struct EaseOutInCubic
 */
 struct EaseInQuart
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return t * t * t * t;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return 4.0 * t * t * t;
+    }
 };
 
 /** Quartic easing (t^4): decelerating to zero
 */
 struct EaseOutQuart
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t -= 1.0;
         return -(t * t * t * t - 1.0);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t -= 1.0;
+        return -4.0 * t * t * t;
+    }
 };
 
 /** Quartic easing (t^4): acceleration halfway, then deceleration
 */
 struct EaseInOutQuart
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t *= 2.0;
         if (t < 1.0) return 0.5 * t * t * t * t;
@@ -178,13 +246,22 @@ struct EaseInOutQuart
         t -= 2.0;
         return -0.5 * (t * t * t * t - 2.0);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t *= 2.0;
+        if (t < 1.0) return 4.0 * t * t * t;
+
+        t -= 2.0;
+        return -4.0 * t * t * t;
+    }
 };
 
 /** Quartic easing (t^4): deceleration halfway, then acceleration
 */
 struct EaseOutInQuart
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -195,6 +272,12 @@ struct EaseOutInQuart
         t = 2.0 * t - 1.0;
         return (t * t * t * t) / 2.0 + 0.5;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        const double u = 2.0 * t - 1.0;
+        return (t < 0.5 ? -4.0 : 4.0) * u * u * u;
+    }
 };
 
 // =============================================================================
@@ -203,28 +286,39 @@ struct EaseOutInQuart
 */
 struct EaseInQuint
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return t * t * t * t * t;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return 5.0 * t * t * t * t;
+    }
 };
 
 /** Quintic easing (t^5): decelerating to zero
 */
 struct EaseOutQuint
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t -= 1.0;
         return t * t * t * t * t + 1.0;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t -= 1.0;
+        return 5.0 * t * t * t * t;
+    }
 };
 
 /** Quintic easing (t^5): accelerating halfway, then deceleration
 */
 struct EaseInOutQuint
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t *= 2.0;
         if (t < 1.0) return 0.5 * t * t * t * t * t;
@@ -232,13 +326,21 @@ struct EaseInOutQuint
         t -= 2.0;
         return 0.5 * (t * t * t * t * t + 2.0);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t *= 2.0;
+        if (t >= 1.0) t -= 2.0;
+
+        return 5.0 * t * t * t * t;
+    }
 };
 
 /** Quintic easing (t^5): accelerating halfway, then deceleration
 */
 struct EaseOutInQuint
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -249,107 +351,198 @@ struct EaseOutInQuint
         t = 2.0 * t - 1.0;
         return (t * t * t * t * t) / 2.0 + 0.5;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t = 2.0 * t - 1.0;
+        return 5.0 * t * t * t * t;
+    }
+};
+
+// =============================================================================
+
+/** The maths functions used by the sine, exponential, circular and elastic
+    easings, taken from the C library.
+
+    Those easings are templates on the set of functions they use, so that the
+    same curves can also be built from EasingFunctions::ConstexprMath and
+    evaluated at compile time. The names without a Basic prefix (EaseInSine,
+    EaseOutElastic, etc.) are the versions using this struct.
+*/
+struct StandardMath
+{
+    static double abs  (double x) noexcept  { return std::abs (x); }
+    static double sin  (double x) noexcept  { return std::sin (x); }
+    static double cos  (double x) noexcept  { return std::cos (x); }
+    static double exp2 (double x) noexcept  { return std::exp2 (x); }
+    static double sqrt (double x) noexcept  { return std::sqrt (x); }
+    static double asin (double x) noexcept  { return std::asin (x); }
 };
 
 // =============================================================================
 
 /** Sinusoidal easing (sin(t)): accelerating from zero
 */
-struct EaseInSine
+template <typename Math>
+struct BasicEaseInSine
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
-        return (t == 1.0) ? 1.0 : -cos(t * (PI / 2.0)) + 1.0;
+        constexpr double PI = juce::MathConstants<double>::pi;
+        return (t == 1.0) ? 1.0 : -Math::cos (t * (PI / 2.0)) + 1.0;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double PI = juce::MathConstants<double>::pi;
+        return (PI / 2.0) * Math::sin (t * (PI / 2.0));
     }
 };
 
 /** Sinusoidal easing (sin(t)): decelerating to zero
 */
-struct EaseOutSine
+template <typename Math>
+struct BasicEaseOutSine
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
-        return sin(t * (PI / 2.0));
+        constexpr double PI = juce::MathConstants<double>::pi;
+        return Math::sin (t * (PI / 2.0));
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double PI = juce::MathConstants<double>::pi;
+        return (PI / 2.0) * Math::cos (t * (PI / 2.0));
     }
 };
 
 /** Sinusoidal easing (sin(t)): acceleration halfway, then deceleration
 */
-struct EaseInOutSine
+template <typename Math>
+struct BasicEaseInOutSine
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
+    {
+        constexpr double PI = juce::MathConstants<double>::pi;
+        return 0.5 * (Math::cos (PI * t) - 1.0);
+    }
+
+    constexpr double derivative (double t) const noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
-        return 0.5 * (cos(PI * t) - 1.0);
+        constexpr double PI = juce::MathConstants<double>::pi;
+        return -0.5 * PI * Math::sin (PI * t);
     }
 };
 
-/** Sinusoidal easing (sin(t)): acceleration halfway, then deceleration
+/** Sinusoidal easing (sin(t)): deceleration halfway, then acceleration
 */
-struct EaseOutInSine
+template <typename Math>
+struct BasicEaseOutInSine
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
+        constexpr double PI = juce::MathConstants<double>::pi;
 
         if (t < 0.5)
         {
             t *= 2.0;
-            return (sin(t * (PI / 2.0))) / 2.0;
+            return (Math::sin (t * (PI / 2.0))) / 2.0;
         }
 
         t = 2.0 * t - 1.0;
         if (t == 1.0) return t / 2.0 + 0.5;
-        return (-cos(t * (PI / 2.0)) + 1.0) / 2.0 + 0.5;
+        return (-Math::cos (t * (PI / 2.0)) + 1.0) / 2.0 + 0.5;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double PI = juce::MathConstants<double>::pi;
+
+        if (t < 0.5)
+            return (PI / 2.0) * Math::cos (t * PI);
+
+        return (PI / 2.0) * Math::sin ((2.0 * t - 1.0) * (PI / 2.0));
     }
 };
 
+using EaseInSine    = BasicEaseInSine<StandardMath>;
+using EaseOutSine   = BasicEaseOutSine<StandardMath>;
+using EaseInOutSine = BasicEaseInOutSine<StandardMath>;
+using EaseOutInSine = BasicEaseOutInSine<StandardMath>;
+
 // =============================================================================
 
 /** Exponential easing (2 ^ t): accelerating from zero
 */
-struct EaseInExpo
+template <typename Math>
+struct BasicEaseInExpo
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t == 0.0 || t == 1.0) return t;
-        return pow(2.0, 10.0 * (t - 1.0)) - 0.001;
+        return Math::exp2 (10.0 * (t - 1.0)) - 0.001;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double ln2 = 0.69314718055994531;
+
+        return 10.0 * ln2 * Math::exp2 (10.0 * (t - 1.0));
     }
 };
 
 /** Exponential easing (2 ^ t): decelerating to zero
 */
-struct EaseOutExpo
+template <typename Math>
+struct BasicEaseOutExpo
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t == 1.0) return t;
-        return 1.001 * (-pow(2.0, -10.0 * t) + 1.0);
+        return 1.001 * (-Math::exp2 (-10.0 * t) + 1.0);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double ln2 = 0.69314718055994531;
+
+        return 1.001 * 10.0 * ln2 * Math::exp2 (-10.0 * t);
     }
 };
 
 /** Exponential easing (2 ^ t): acceleration halfway, then deceleration
 */
-struct EaseInOutExpo
+template <typename Math>
+struct BasicEaseInOutExpo
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t == 0.0 || t == 1.0) return t;
 
         t *= 2.0;
 
-        if (t < 1.0) return 0.5 * pow(2.0, 10.0 * (1.0 - 1.0)) - 0.0005;
-        return 0.5 * 1.0005 * -pow(2.0, -10 * (t - 1.0)) + 2.0;
+        if (t < 1.0) return 0.5 * Math::exp2 (10.0 * (1.0 - 1.0)) - 0.0005;
+        return 0.5 * 1.0005 * -Math::exp2 (-10 * (t - 1.0)) + 2.0;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double ln2 = 0.69314718055994531;
+
+        t *= 2.0;
+
+        if (t < 1.0) return 0.0;
+        return 1.0005 * 10.0 * ln2 * Math::exp2 (-10 * (t - 1.0));
     }
 };
 
 /** Exponential easing (2 ^ t): deceleration halfway, then acceleration
 */
-struct EaseOutInExpo
+template <typename Math>
+struct BasicEaseOutInExpo
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -358,7 +551,7 @@ struct EaseOutInExpo
             if (t == 0.0 || t == 1.0)
                 return t / 2.0;
 
-            return (1.001 * (-pow(2.0, -10.0 * t) + 1.0)) / 2.0;
+            return (1.001 * (-Math::exp2 (-10.0 * t) + 1.0)) / 2.0;
         }
 
         t = 2.0 * t - 1.0;
@@ -366,203 +559,420 @@ struct EaseOutInExpo
         if (t == 0.0 || t == 1.0)
             return t / 2.0 + 0.5;
 
-        return (pow(2.0, 10.0 * (t - 1.0)) - 0.001) / 2.0 + 0.5;
+        return (Math::exp2 (10.0 * (t - 1.0)) - 0.001) / 2.0 + 0.5;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        constexpr double ln2 = 0.69314718055994531;
+
+        if (t < 0.5)
+            return 1.001 * 10.0 * ln2 * Math::exp2 (-20.0 * t);
+
+        return 10.0 * ln2 * Math::exp2 (10.0 * (2.0 * t - 2.0));
     }
 };
 
+using EaseInExpo    = BasicEaseInExpo<StandardMath>;
+using EaseOutExpo   = BasicEaseOutExpo<StandardMath>;
+using EaseInOutExpo = BasicEaseInOutExpo<StandardMath>;
+using EaseOutInExpo = BasicEaseOutInExpo<StandardMath>;
+
 //==============================================================================
 
 /** Circular easing (sqrt(1-t^2)): accelerating from zero
 */
-struct EaseInCirc
+template <typename Math>
+struct BasicEaseInCirc
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
-        return -(sqrt(1.0 - t * t) - 1.0);
+        return -(Math::sqrt (1.0 - t * t) - 1.0);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return t / Math::sqrt (1.0 - t * t);
     }
 };
 
 /** Circular easing (sqrt(1-t^2)): decelerating to zero
 */
-struct EaseOutCirc
+template <typename Math>
+struct BasicEaseOutCirc
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
+    {
+        t -= 1.0;
+        return Math::sqrt (1.0 - t * t);
+    }
+
+    constexpr double derivative (double t) const noexcept
     {
         t -= 1.0;
-        return sqrt(1.0 - t * t);
+        return -t / Math::sqrt (1.0 - t * t);
     }
 };
 
 /** Circular easing (sqrt(1-t^2)): acceleration halfway, then deceleration
 */
-struct EaseInOutCirc
+template <typename Math>
+struct BasicEaseInOutCirc
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t *= 2.0;
-        if (t < 1.0) return -0.5 * (sqrt(1.0 - t * t) - 1.0);
+        if (t < 1.0) return -0.5 * (Math::sqrt (1.0 - t * t) - 1.0);
 
         t -= 2.0;
-        return 0.5 * (sqrt(1.0 - t * t) + 1.0);
+        return 0.5 * (Math::sqrt (1.0 - t * t) + 1.0);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t *= 2.0;
+        if (t < 1.0) return t / Math::sqrt (1.0 - t * t);
+
+        t -= 2.0;
+        return -t / Math::sqrt (1.0 - t * t);
     }
 };
 
 /** Circular easing (sqrt(1-t^2)): deceleration halfway, then acceleration
 */
-struct EaseOutInCirc
+template <typename Math>
+struct BasicEaseOutInCirc
 {
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
             t = (2.0 * t) - 1.0;
-            return sqrt(1.0 - t * t) / 2.0;
+            return Math::sqrt (1.0 - t * t) / 2.0;
         }
 
         t = 2.0 * t - 1.0;
-        return -(sqrt(1.0 - t * t) - 1.0) / 2.0 + 0.5;
+        return -(Math::sqrt (1.0 - t * t) - 1.0) / 2.0 + 0.5;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t = 2.0 * t - 1.0;
+        return (t < 0.0 ? -t : t) / Math::sqrt (1.0 - t * t);
     }
 };
 
+using EaseInCirc    = BasicEaseInCirc<StandardMath>;
+using EaseOutCirc   = BasicEaseOutCirc<StandardMath>;
+using EaseInOutCirc = BasicEaseInOutCirc<StandardMath>;
+using EaseOutInCirc = BasicEaseOutInCirc<StandardMath>;
+
 //==============================================================================
 
-/** Elastic easing (exponentially decaying sinusoid): accelerating from zero
+/** Polynomial approximations used by the elastic easings when their fast
+    approximation mode is enabled.
 */
-struct EaseInElastic
+namespace FastMath
 {
-    double amplitude = 1.0, period = 1.0;
+    /** Rounds to the nearest integer, avoiding a library call to floor(). */
+    inline double roundToNearest (double x) noexcept
+    {
+        x += 0.5;
 
-    double operator() (double t) const noexcept
+        const double truncated = (double) (int64) x;
+        return truncated > x ? truncated - 1.0 : truncated;
+    }
+
+    /** Approximates 2^x. The fractional part is evaluated with a degree 6
+        polynomial over [-0.5, 0.5], giving a relative error below 2.0e-7 for
+        any x in [-1022, 1023]. Smaller inputs return 0.
+    */
+    inline double exp2 (double x) noexcept
     {
-        return helper(t, 0.0, 1.0, 1.0, amplitude, period);
+        if (x < -1022.0)
+            return 0.0;
+
+        const double n = roundToNearest (x);
+        const double f = (x - n) * 0.69314718055994531;
+
+        const double p = 1.0 + f * (1.0 + f * (1.0 / 2.0 + f * (1.0 / 6.0 + f * (1.0 / 24.0
+                           + f * (1.0 / 120.0 + f * (1.0 / 720.0))))));
+
+        const auto bits = (uint64) ((int64) n + 1023) << 52;
+        double scale;
+        std::memcpy (&scale, &bits, sizeof (scale));
+
+        return p * scale;
     }
 
-    static double
-    helper(double t, double b, double c, double d, double a, double p)
+    /** Approximates sin (x). The argument is reduced to [-pi/2, pi/2] and
+        evaluated with a degree 11 odd polynomial, giving an absolute error
+        below 1.0e-7 for |x| < 1.0e6.
+    */
+    inline double sin (double x) noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
+        const double pi    = juce::MathConstants<double>::pi;
+        const double twoPi = juce::MathConstants<double>::twoPi;
 
-        if (t == 0.0) return b;
+        x -= twoPi * roundToNearest (x / twoPi);
 
-        double t_adj = t / d;
+        if (x > pi / 2.0)       x = pi - x;
+        else if (x < -pi / 2.0) x = -pi - x;
 
-        if (t_adj == 1.0) return b + c;
+        const double x2 = x * x;
 
-        float s;
-        if (a < fabs(c))
-        {
-            a = c;
-            s = p / 4.0;
-        }
-        else
+        return x * (1.0 - x2 * (1.0 / 6.0 - x2 * (1.0 / 120.0 - x2 * (1.0 / 5040.0
+                 - x2 * (1.0 / 362880.0 - x2 * (1.0 / 39916800.0))))));
+    }
+}
+
+/** Base class for the elastic easings.
+
+    The amplitude and period only change through setParameters(), which
+    precomputes the clamped amplitude, the phase shift and the angular
+    frequency of the sinusoid, so that evaluating the curve only needs one
+    exp2 and one sin.
+
+    If setUseFastApproximation() is enabled, those are replaced by the
+    polynomial approximations in EasingFunctions::FastMath. The result then
+    differs from the exact curve by less than 3.0e-7 times the amplitude,
+    which is invisible on screen. The approximations are branch-light and can
+    be inlined, so they are cheaper than the C library calls, although by how
+    much depends a lot on the platform's maths library.
+
+    When the template argument is ConstexprMath, the constructor and the curves
+    can be evaluated at compile time, as long as the fast approximation is left
+    disabled.
+*/
+template <typename Math>
+class BasicElasticEasing
+{
+public:
+    /** Changes the amplitude and period of the curve. */
+    void setParameters (double newAmplitude, double newPeriod) noexcept
+    {
+        jassert (newPeriod > 0.0);
+
+        amplitude = newAmplitude;
+        period = newPeriod;
+
+        full = Coefficients (amplitude, period, 1.0);
+        half = Coefficients (amplitude, period, 0.5);
+    }
+
+    /** Returns the amplitude of the curve. */
+    constexpr double getAmplitude() const noexcept      { return amplitude; }
+
+    /** Returns the period of the curve. */
+    constexpr double getPeriod() const noexcept         { return period; }
+
+    /** Enables the polynomial exp2 and sin approximations. */
+    void setUseFastApproximation (bool shouldUseFastApproximation) noexcept
+    {
+        useFastApproximation = shouldUseFastApproximation;
+    }
+
+    /** Returns true if the polynomial approximations are being used. */
+    constexpr bool isUsingFastApproximation() const noexcept  { return useFastApproximation; }
+
+protected:
+    constexpr BasicElasticEasing (double initialAmplitude, double initialPeriod) noexcept
+        : amplitude (initialAmplitude),
+          period (initialPeriod),
+          full (initialAmplitude, initialPeriod, 1.0),
+          half (initialAmplitude, initialPeriod, 0.5)
+    {
+        jassert (initialPeriod > 0.0);
+    }
+
+    /** The terms of a * 2^(10t) * sin ((t - s) * w) for a curve covering a change
+        in value of c.
+    */
+    struct Coefficients
+    {
+        constexpr Coefficients (double a, double p, double c) noexcept
+            : clampedAmplitude (a < Math::abs (c) ? c : a),
+              shift (a < Math::abs (c) ? p / 4.0
+                                       : p / juce::MathConstants<double>::twoPi * Math::asin (c / a)),
+              angularFrequency (juce::MathConstants<double>::twoPi / p)
         {
-            s = p / (2.0 * PI) * asin(c / a);
         }
 
-        t_adj -= 1.0;
+        double clampedAmplitude, shift, angularFrequency;
+    };
+
+    constexpr double exp2 (double x) const noexcept
+    {
+        return useFastApproximation ? FastMath::exp2 (x) : Math::exp2 (x);
+    }
+
+    constexpr double sine (double x) const noexcept
+    {
+        return useFastApproximation ? FastMath::sin (x) : Math::sin (x);
+    }
+
+    constexpr double cosine (double x) const noexcept
+    {
+        return useFastApproximation ? FastMath::sin (x + juce::MathConstants<double>::halfPi)
+                                    : Math::cos (x);
+    }
+
+    /** Accelerates from b to b + c. */
+    constexpr double easeIn (const Coefficients& k, double t, double b, double c) const noexcept
+    {
+        if (t == 0.0) return b;
+        if (t == 1.0) return b + c;
+
+        t -= 1.0;
+
+        return -(k.clampedAmplitude * exp2 (10.0 * t)
+                 * sine ((t - k.shift) * k.angularFrequency)) + b;
+    }
+
+    /** Decelerates from b to b + c. */
+    constexpr double easeOut (const Coefficients& k, double t, double b, double c) const noexcept
+    {
+        if (t == 0.0) return b;
+        if (t == 1.0) return b + c;
+
+        return k.clampedAmplitude * exp2 (-10.0 * t)
+               * sine ((t - k.shift) * k.angularFrequency) + c + b;
+    }
+
+    /** Returns the slope of easeIn(), which doesn't depend on b or c. */
+    constexpr double easeInDerivative (const Coefficients& k, double t) const noexcept
+    {
+        constexpr double ln2 = 0.69314718055994531;
+
+        t -= 1.0;
+        const double phase = (t - k.shift) * k.angularFrequency;
+
+        return -k.clampedAmplitude * exp2 (10.0 * t)
+                 * (10.0 * ln2 * sine (phase) + k.angularFrequency * cosine (phase));
+    }
+
+    /** Returns the slope of easeOut(), which doesn't depend on b or c. */
+    constexpr double easeOutDerivative (const Coefficients& k, double t) const noexcept
+    {
+        constexpr double ln2 = 0.69314718055994531;
+        const double phase = (t - k.shift) * k.angularFrequency;
 
-        return -(a * pow(2.0, 10.0 * t_adj)
-               * sin((t_adj * d - s) * (2.0 * PI) / p));
+        return k.clampedAmplitude * exp2 (-10.0 * t)
+                 * (k.angularFrequency * cosine (phase) - 10.0 * ln2 * sine (phase));
     }
+
+    double amplitude, period;
+    Coefficients full, half;
+    bool useFastApproximation = false;
 };
 
-/** Elastic easing (exponentially decaying sinusoid): decelerating to zero
+/** Elastic easing (exponentially decaying sinusoid): accelerating from zero
 */
-struct EaseOutElastic
+template <typename Math>
+struct BasicEaseInElastic  : public BasicElasticEasing<Math>
 {
-    double amplitude = 1.0, period = 1.0;
+    constexpr BasicEaseInElastic (double newAmplitude = 1.0, double newPeriod = 1.0) noexcept
+        : BasicElasticEasing<Math> (newAmplitude, newPeriod) {}
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
-        return helper(t, 0.0, 1.0, 1.0, amplitude, period);
+        return this->easeIn (this->full, t, 0.0, 1.0);
     }
 
-    static double
-    helper(double t, double b, double c, double d, double a, double p)
+    constexpr double derivative (double t) const noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
+        return this->easeInDerivative (this->full, t);
+    }
+};
 
-        if (t == 0.0) return t;
-        if (t == 1.0) return c;
+/** Elastic easing (exponentially decaying sinusoid): decelerating to zero
+*/
+template <typename Math>
+struct BasicEaseOutElastic  : public BasicElasticEasing<Math>
+{
+    constexpr BasicEaseOutElastic (double newAmplitude = 1.0, double newPeriod = 1.0) noexcept
+        : BasicElasticEasing<Math> (newAmplitude, newPeriod) {}
 
-        float s;
-        if (a < c)
-        {
-            a = c;
-            s = p / 4.0;
-        }
-        else
-        {
-            s = p / (2.0 * PI) * asin(c / a);
-        }
+    constexpr double operator() (double t) const noexcept
+    {
+        return this->easeOut (this->full, t, 0.0, 1.0);
+    }
 
-        return a * pow(2.0, -10.0 * t) * sin((t - s) * (2.0 * PI) / p) + c;
+    constexpr double derivative (double t) const noexcept
+    {
+        return this->easeOutDerivative (this->full, t);
     }
 };
 
 /** Elastic easing (exponentially decaying sinusoid): acceleration halfway, then
    deceleration
 */
-struct EaseInOutElastic
+template <typename Math>
+struct BasicEaseInOutElastic  : public BasicElasticEasing<Math>
 {
-    double amplitude = 1.0, period = 1.0;
+    constexpr BasicEaseInOutElastic (double newAmplitude = 1.0, double newPeriod = 1.0) noexcept
+        : BasicElasticEasing<Math> (newAmplitude, newPeriod) {}
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
-        const double PI = juce::MathConstants<double>::pi;
-
         if (t == 0.0) return 0.0;
 
         t *= 2.0;
 
         if (t == 2.0) return 1.0;
 
-        double s;
-        double a = amplitude;
+        t -= 1.0;
 
-        if (amplitude < 1.0)
-        {
-            a = 1.0;
-            s = period / 4.0;
-        }
-        else
-        {
-            s = period / (2.0 * PI) * asin(1.0 / a);
-        }
+        const auto& k = this->full;
+        const double oscillation = k.clampedAmplitude * this->sine ((t - k.shift) * k.angularFrequency);
 
-        if (t < 1.0)
-        {
-            return -0.5 * (a * pow(2.0, 10.0 * (t - 1.0))
-                   * sin((t - 1.0 - s) * (2.0 * PI) / period));
-        }
+        if (t < 0.0)
+            return -0.5 * (this->exp2 (10.0 * t) * oscillation);
 
-        return a * pow(2.0, -10.0 * (t - 1.0))
-               * sin((t - 1.0 - s) * (2.0 * PI) / period) * 0.5 + 1.0;
+        return this->exp2 (-10.0 * t) * oscillation * 0.5 + 1.0;
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        if (t < 0.5)
+            return this->easeInDerivative (this->full, 2.0 * t);
+
+        return this->easeOutDerivative (this->full, 2.0 * t - 1.0);
     }
 };
 
 /** Elastic easing (exponentially decaying sinusoid): deceleration halfway, then
    acceleration
 */
-struct EaseOutInElastic
+template <typename Math>
+struct BasicEaseOutInElastic  : public BasicElasticEasing<Math>
 {
-    double amplitude = 1.0, period = 1.0;
+    constexpr BasicEaseOutInElastic (double newAmplitude = 1.0, double newPeriod = 1.0) noexcept
+        : BasicElasticEasing<Math> (newAmplitude, newPeriod) {}
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
-        {
-            return EaseOutElastic::helper(
-                t * 2.0, 0.0, 0.5, 1.0, amplitude, period
-            );
-        }
+            return this->easeOut (this->half, t * 2.0, 0.0, 0.5);
+
+        return this->easeIn (this->half, 2.0 * t - 1.0, 0.5, 0.5);
+    }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        if (t < 0.5)
+            return 2.0 * this->easeOutDerivative (this->half, t * 2.0);
 
-        return EaseInElastic::helper(
-            2.0 * t - 1.0, 0.5, 0.5, 1.0, amplitude, period
-        );
+        return 2.0 * this->easeInDerivative (this->half, 2.0 * t - 1.0);
     }
 };
 
+using ElasticEasing    = BasicElasticEasing<StandardMath>;
+using EaseInElastic    = BasicEaseInElastic<StandardMath>;
+using EaseOutElastic   = BasicEaseOutElastic<StandardMath>;
+using EaseInOutElastic = BasicEaseInOutElastic<StandardMath>;
+using EaseOutInElastic = BasicEaseOutInElastic<StandardMath>;
+
 //==============================================================================
 
 /** Back easing (overshoot cubic: (s+1)*t^3 - s*t^2): accelerating from zero
@@ -571,10 +981,15 @@ struct EaseInBack
 {
     double overshoot = 1.70158;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return t * t * ((overshoot + 1.0) * t - overshoot);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return 3.0 * (overshoot + 1.0) * t * t - 2.0 * overshoot * t;
+    }
 };
 
 /** Back easing (overshoot cubic: (s+1)*t^3 - s*t^2): decelerating to zero
@@ -583,11 +998,17 @@ struct EaseOutBack
 {
     double overshoot = 1.70158;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         t -= 1.0;
         return t * t * ((overshoot + 1.0) * t + overshoot) + 1.0;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        t -= 1.0;
+        return 3.0 * (overshoot + 1.0) * t * t + 2.0 * overshoot * t;
+    }
 };
 
 /** Back easing (overshoot cubic: (s+1)*t^3 - s*t^2): acceleration halfway, then
@@ -597,7 +1018,7 @@ struct EaseInOutBack
 {
     double overshoot = 1.70158;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         double s = overshoot;
 
@@ -614,6 +1035,17 @@ struct EaseInOutBack
             return 0.5 * (t * t * ((s + 1.0) * t + s) + 2.0);
         }
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        const double s = overshoot * 1.525;
+
+        t *= 2.0;
+        if (t < 1.0) return 3.0 * (s + 1.0) * t * t - 2.0 * s * t;
+
+        t -= 2.0;
+        return 3.0 * (s + 1.0) * t * t + 2.0 * s * t;
+    }
 };
 
 /** Back easing (overshoot cubic: (s+1)*t^3 - s*t^2): deceleration halfway, then
@@ -623,7 +1055,7 @@ struct EaseOutInBack
 {
     double overshoot = 1.70158;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -634,6 +1066,16 @@ struct EaseOutInBack
         t = 2.0 * t - 1.0;
         return (t * t * ((overshoot + 1.0) * t - overshoot)) / 2.0 + 0.5;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        const double u = 2.0 * t - 1.0;
+
+        if (t < 0.5)
+            return 3.0 * (overshoot + 1.0) * u * u + 2.0 * overshoot * u;
+
+        return 3.0 * (overshoot + 1.0) * u * u - 2.0 * overshoot * u;
+    }
 };
 
 //==============================================================================
@@ -644,12 +1086,17 @@ struct EaseOutBounce
 {
     double amplitude = 1.0;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return helper(t, 1.0, amplitude);
     }
 
-    static double helper(double t, double c, double a)
+    constexpr double derivative (double t) const noexcept
+    {
+        return helperDerivative(t, 1.0, amplitude);
+    }
+
+    static constexpr double helper(double t, double c, double a) noexcept
     {
         if (t == 1.0) return c;
 
@@ -673,6 +1120,15 @@ struct EaseOutBounce
             return -a * (1.0 - (7.5625 * t * t + 0.984375)) + c;
         }
     }
+
+    static constexpr double helperDerivative(double t, double c, double a) noexcept
+    {
+        if (t < 4.0 / 11.0)  return c * 15.125 * t;
+        if (t < 8.0 / 11.0)  return a * 15.125 * (t - 6.0 / 11.0);
+        if (t < 10.0 / 11.0) return a * 15.125 * (t - 9.0 / 11.0);
+
+        return a * 15.125 * (t - 21.0 / 22.0);
+    }
 };
 
 /** Bounce easing (exponentially decaying parabola): accelerating from zero
@@ -681,10 +1137,15 @@ struct EaseInBounce
 {
     double amplitude = 1.0;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         return 1.0 - EaseOutBounce::helper(1.0 - t, 1.0, amplitude);
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        return EaseOutBounce::helperDerivative(1.0 - t, 1.0, amplitude);
+    }
 };
 
 /** Bounce easing (exponentially decaying parabola): acceleration halfway, then
@@ -694,7 +1155,7 @@ struct EaseInOutBounce
 {
     double amplitude = 1.0;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5)
         {
@@ -707,6 +1168,12 @@ struct EaseInOutBounce
         t = 2.0 * t - 1.0;
         return EaseOutBounce::helper(t, 1.0, amplitude) / 2.0 + 0.5;
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        if (t < 0.5) return EaseOutBounce::helperDerivative(1.0 - (2.0 * t), 1.0, amplitude);
+        return EaseOutBounce::helperDerivative(2.0 * t - 1.0, 1.0, amplitude);
+    }
 };
 
 /** Bounce easing (exponentially decaying parabola): deceleration halfway, then
@@ -716,11 +1183,222 @@ struct EaseOutInBounce
 {
     double amplitude = 1.0;
 
-    double operator() (double t) const noexcept
+    constexpr double operator() (double t) const noexcept
     {
         if (t < 0.5) return EaseOutBounce::helper(t * 2.0, 0.5, amplitude);
         return (1.0 - EaseOutBounce::helper(2.0 - 2.0 * t, 0.5, amplitude));
     }
+
+    constexpr double derivative (double t) const noexcept
+    {
+        if (t < 0.5) return 2.0 * EaseOutBounce::helperDerivative(t * 2.0, 0.5, amplitude);
+        return 2.0 * EaseOutBounce::helperDerivative(2.0 - 2.0 * t, 0.5, amplitude);
+    }
+};
+
+//==============================================================================
+
+namespace SIMDDetail { template <typename EasingType> struct BlockKernel; }
+
+/** Cubic Bezier easing, equivalent to the CSS cubic-bezier(x1, y1, x2, y2)
+    timing function.
+
+    The curve runs from (0, 0) to (1, 1) with control points (x1, y1) and
+    (x2, y2), where x1 and x2 must be in [0, 1] so that the curve is a function
+    of x. Evaluating it means finding the curve parameter for a given x, so the
+    constructor samples x at evenly spaced parameters, and each evaluation uses
+    that table to seed a few Newton-Raphson steps, falling back to bisection
+    where the curve is too flat for Newton-Raphson to converge. The samples are
+    stored inline, so the functor can be copied freely without allocating.
+
+    Outside [0, 1] the curve is extended along its end tangents, as CSS does.
+
+    EasingFunctions::processBlock() runs the Newton-Raphson steps for several
+    values at once, and only falls back to the scalar solver for the values
+    that need bisection.
+*/
+class EaseCubicBezier
+{
+public:
+    /** Creates the curve from its two control points. The default is the CSS
+        "ease" curve.
+    */
+    EaseCubicBezier (double x1 = 0.25, double y1 = 0.1, double x2 = 0.25, double y2 = 1.0) noexcept
+        : controlX1 (x1), controlY1 (y1), controlX2 (x2), controlY2 (y2)
+    {
+        // the x coordinates must be in [0, 1] for the curve to be a function of x
+        jassert (x1 >= 0.0 && x1 <= 1.0 && x2 >= 0.0 && x2 <= 1.0);
+
+        x1 = jlimit (0.0, 1.0, x1);
+        x2 = jlimit (0.0, 1.0, x2);
+
+        cx = 3.0 * x1;
+        bx = 3.0 * (x2 - x1) - cx;
+        ax = 1.0 - cx - bx;
+
+        cy = 3.0 * y1;
+        by = 3.0 * (y2 - y1) - cy;
+        ay = 1.0 - cy - by;
+
+        isLinear = (x1 == y1 && x2 == y2);
+
+        for (int i = 0; i < numSamples; ++i)
+            samples[(size_t) i] = sampleX (i * sampleSpacing);
+
+        if (x1 > 0.0)                       startGradient = y1 / x1;
+        else if (y1 == 0.0 && x2 > 0.0)     startGradient = y2 / x2;
+
+        if (x2 < 1.0)                       endGradient = (y2 - 1.0) / (x2 - 1.0);
+        else if (y2 == 1.0 && x1 < 1.0)     endGradient = (y1 - 1.0) / (x1 - 1.0);
+    }
+
+    double operator() (double x) const noexcept
+    {
+        if (isLinear)
+            return x;
+
+        if (x <= 0.0 || x >= 1.0)
+            return extrapolate (x);
+
+        return sampleY (solve (x, findInterval (x, 0)));
+    }
+
+    double derivative (double x) const noexcept
+    {
+        if (isLinear)
+            return 1.0;
+
+        if (x <= 0.0 || x >= 1.0)
+            return x <= 0.0 ? startGradient : endGradient;
+
+        const double t = solve (x, findInterval (x, 0));
+        return slopeY (t) / slopeX (t);
+    }
+
+    /** Returns the control points the curve was created with. */
+    double getX1() const noexcept                       { return controlX1; }
+    double getY1() const noexcept                       { return controlY1; }
+    double getX2() const noexcept                       { return controlX2; }
+    double getY2() const noexcept                       { return controlY2; }
+
+private:
+    friend struct SIMDDetail::BlockKernel<EaseCubicBezier>;
+
+    static constexpr int numSamples = 11;
+    static constexpr double sampleSpacing = 1.0 / (numSamples - 1);
+    static constexpr int newtonIterations = 4;
+    static constexpr double newtonMinimumSlope = 0.02;
+    static constexpr int bisectionIterations = 44;
+    static constexpr double precision = 1.0e-12;
+
+    double sampleX (double t) const noexcept            { return ((ax * t + bx) * t + cx) * t; }
+    double sampleY (double t) const noexcept            { return ((ay * t + by) * t + cy) * t; }
+    double slopeX (double t) const noexcept             { return (3.0 * ax * t + 2.0 * bx) * t + cx; }
+    double slopeY (double t) const noexcept             { return (3.0 * ay * t + 2.0 * by) * t + cy; }
+
+    double extrapolate (double x) const noexcept
+    {
+        return x <= 0.0 ? startGradient * x
+                        : 1.0 + endGradient * (x - 1.0);
+    }
+
+    /** Returns the index of the table interval containing x, searching outwards
+        from a starting index. x must be in (0, 1).
+    */
+    int findInterval (double x, int start) const noexcept
+    {
+        int i = start;
+
+        while (i > 0 && samples[(size_t) i] > x)
+            --i;
+
+        while (i < numSamples - 2 && samples[(size_t) i + 1] <= x)
+            ++i;
+
+        return i;
+    }
+
+    /** Returns a first estimate of the curve parameter for x, by interpolating
+        between the two samples of a table interval.
+    */
+    double getInitialGuess (double x, int interval) const noexcept
+    {
+        const double lowX = samples[(size_t) interval];
+        const double highX = samples[(size_t) interval + 1];
+        const double lowT = interval * sampleSpacing;
+
+        if (highX > lowX)
+            return lowT + sampleSpacing * (x - lowX) / (highX - lowX);
+
+        return lowT;
+    }
+
+    /** Finds the curve parameter whose x coordinate is x, within a table interval. */
+    double solve (double x, int interval) const noexcept
+    {
+        double t = getInitialGuess (x, interval);
+
+        if (slopeX (t) >= newtonMinimumSlope)
+        {
+            for (int i = 0; i < newtonIterations; ++i)
+                t -= (sampleX (t) - x) / slopeX (t);
+
+            if (std::abs (sampleX (t) - x) < precision)
+                return t;
+        }
+
+        // too flat for Newton-Raphson, so narrow down the table interval instead
+        double low = interval * sampleSpacing, high = low + sampleSpacing;
+
+        for (int i = 0; i < bisectionIterations; ++i)
+        {
+            t = 0.5 * (low + high);
+            const double error = sampleX (t) - x;
+
+            if (error == 0.0)
+                break;
+
+            (error > 0.0 ? high : low) = t;
+        }
+
+        return t;
+    }
+
+    double controlX1, controlY1, controlX2, controlY2;
+    double ax, bx, cx, ay, by, cy;
+    double startGradient = 0.0, endGradient = 0.0;
+    bool isLinear;
+    std::array<double, numSamples> samples;
 };
 
+//==============================================================================
+/** Detects whether an easing type has a derivative() member. */
+template <typename EasingType, typename = void>
+struct HasDerivative  : std::false_type {};
+
+template <typename EasingType>
+struct HasDerivative<EasingType, decltype ((void) std::declval<const EasingType&>().derivative (0.0))>
+    : std::true_type {};
+
+/** Returns the slope of an easing curve at t.
+
+    Every type in this namespace has a closed form derivative() member, which
+    is used when it's available. For anything else, such as a lambda or a
+    std::function, this falls back to a central difference, which costs two
+    calls to the curve.
+*/
+template <typename EasingType>
+constexpr double getDerivative (const EasingType& easing, double t) noexcept
+{
+    if constexpr (HasDerivative<EasingType>::value)
+    {
+        return easing.derivative (t);
+    }
+    else
+    {
+        constexpr double h = 1.0e-6;
+        return (easing (t + h) - easing (t - h)) / (2.0 * h);
+    }
+}
+
 }
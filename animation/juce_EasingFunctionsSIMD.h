@@ -0,0 +1,711 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace EasingFunctions
+{
+
+/** Contains the register wrappers and per-easing kernels used by
+    processBlock(). You shouldn't need to use anything in here directly.
+*/
+namespace SIMDDetail
+{
+
+//==============================================================================
+/** A single double that behaves like a one-lane register. This is used for the
+    tail of a block and whenever no vector instruction set is available, so the
+    kernels below only have to be written once.
+*/
+struct ScalarRegister
+{
+    static constexpr int size = 1;
+
+    struct Mask { bool value; };
+
+    ScalarRegister() = default;
+    ScalarRegister (double v) noexcept : value (v) {}
+
+    static ScalarRegister load (const double* src) noexcept   { return *src; }
+    void store (double* dest) const noexcept                  { *dest = value; }
+
+    friend ScalarRegister operator+ (ScalarRegister a, ScalarRegister b) noexcept { return a.value + b.value; }
+    friend ScalarRegister operator- (ScalarRegister a, ScalarRegister b) noexcept { return a.value - b.value; }
+    friend ScalarRegister operator* (ScalarRegister a, ScalarRegister b) noexcept { return a.value * b.value; }
+    friend ScalarRegister operator/ (ScalarRegister a, ScalarRegister b) noexcept { return a.value / b.value; }
+    friend ScalarRegister operator- (ScalarRegister a) noexcept                   { return -a.value; }
+
+    friend Mask operator<  (ScalarRegister a, ScalarRegister b) noexcept { return { a.value <  b.value }; }
+    friend Mask operator== (ScalarRegister a, ScalarRegister b) noexcept { return { a.value == b.value }; }
+    friend Mask operator|  (Mask a, Mask b) noexcept                     { return { a.value || b.value }; }
+
+    friend ScalarRegister select (Mask m, ScalarRegister a, ScalarRegister b) noexcept
+    {
+        return m.value ? a : b;
+    }
+
+    friend ScalarRegister sqrt (ScalarRegister a) noexcept { return std::sqrt (a.value); }
+
+    double value;
+};
+
+//==============================================================================
+#if JUCE_ANIMATION_USE_AVX2
+
+/** Four doubles in an AVX register. */
+struct NativeRegister
+{
+    static constexpr int size = 4;
+
+    struct Mask { __m256d value; };
+
+    NativeRegister() = default;
+    NativeRegister (__m256d v) noexcept : value (v) {}
+    NativeRegister (double v) noexcept  : value (_mm256_set1_pd (v)) {}
+
+    static NativeRegister load (const double* src) noexcept   { return _mm256_loadu_pd (src); }
+    void store (double* dest) const noexcept                  { _mm256_storeu_pd (dest, value); }
+
+    friend NativeRegister operator+ (NativeRegister a, NativeRegister b) noexcept { return _mm256_add_pd (a.value, b.value); }
+    friend NativeRegister operator- (NativeRegister a, NativeRegister b) noexcept { return _mm256_sub_pd (a.value, b.value); }
+    friend NativeRegister operator* (NativeRegister a, NativeRegister b) noexcept { return _mm256_mul_pd (a.value, b.value); }
+    friend NativeRegister operator/ (NativeRegister a, NativeRegister b) noexcept { return _mm256_div_pd (a.value, b.value); }
+    friend NativeRegister operator- (NativeRegister a) noexcept                   { return _mm256_xor_pd (a.value, _mm256_set1_pd (-0.0)); }
+
+    friend Mask operator<  (NativeRegister a, NativeRegister b) noexcept { return { _mm256_cmp_pd (a.value, b.value, _CMP_LT_OQ) }; }
+    friend Mask operator== (NativeRegister a, NativeRegister b) noexcept { return { _mm256_cmp_pd (a.value, b.value, _CMP_EQ_OQ) }; }
+    friend Mask operator|  (Mask a, Mask b) noexcept                     { return { _mm256_or_pd (a.value, b.value) }; }
+
+    friend NativeRegister select (Mask m, NativeRegister a, NativeRegister b) noexcept
+    {
+        return _mm256_blendv_pd (b.value, a.value, m.value);
+    }
+
+    friend NativeRegister sqrt (NativeRegister a) noexcept { return _mm256_sqrt_pd (a.value); }
+
+    __m256d value;
+};
+
+#elif JUCE_ANIMATION_USE_SSE2
+
+/** Two doubles in an SSE register. */
+struct NativeRegister
+{
+    static constexpr int size = 2;
+
+    struct Mask { __m128d value; };
+
+    NativeRegister() = default;
+    NativeRegister (__m128d v) noexcept : value (v) {}
+    NativeRegister (double v) noexcept  : value (_mm_set1_pd (v)) {}
+
+    static NativeRegister load (const double* src) noexcept   { return _mm_loadu_pd (src); }
+    void store (double* dest) const noexcept                  { _mm_storeu_pd (dest, value); }
+
+    friend NativeRegister operator+ (NativeRegister a, NativeRegister b) noexcept { return _mm_add_pd (a.value, b.value); }
+    friend NativeRegister operator- (NativeRegister a, NativeRegister b) noexcept { return _mm_sub_pd (a.value, b.value); }
+    friend NativeRegister operator* (NativeRegister a, NativeRegister b) noexcept { return _mm_mul_pd (a.value, b.value); }
+    friend NativeRegister operator/ (NativeRegister a, NativeRegister b) noexcept { return _mm_div_pd (a.value, b.value); }
+    friend NativeRegister operator- (NativeRegister a) noexcept                   { return _mm_xor_pd (a.value, _mm_set1_pd (-0.0)); }
+
+    friend Mask operator<  (NativeRegister a, NativeRegister b) noexcept { return { _mm_cmplt_pd (a.value, b.value) }; }
+    friend Mask operator== (NativeRegister a, NativeRegister b) noexcept { return { _mm_cmpeq_pd (a.value, b.value) }; }
+    friend Mask operator|  (Mask a, Mask b) noexcept                     { return { _mm_or_pd (a.value, b.value) }; }
+
+    friend NativeRegister select (Mask m, NativeRegister a, NativeRegister b) noexcept
+    {
+        return _mm_or_pd (_mm_and_pd (m.value, a.value), _mm_andnot_pd (m.value, b.value));
+    }
+
+    friend NativeRegister sqrt (NativeRegister a) noexcept { return _mm_sqrt_pd (a.value); }
+
+    __m128d value;
+};
+
+#elif JUCE_ANIMATION_USE_NEON
+
+/** Two doubles in a NEON register. */
+struct NativeRegister
+{
+    static constexpr int size = 2;
+
+    struct Mask { uint64x2_t value; };
+
+    NativeRegister() = default;
+    NativeRegister (float64x2_t v) noexcept : value (v) {}
+    NativeRegister (double v) noexcept      : value (vdupq_n_f64 (v)) {}
+
+    static NativeRegister load (const double* src) noexcept   { return vld1q_f64 (src); }
+    void store (double* dest) const noexcept                  { vst1q_f64 (dest, value); }
+
+    friend NativeRegister operator+ (NativeRegister a, NativeRegister b) noexcept { return vaddq_f64 (a.value, b.value); }
+    friend NativeRegister operator- (NativeRegister a, NativeRegister b) noexcept { return vsubq_f64 (a.value, b.value); }
+    friend NativeRegister operator* (NativeRegister a, NativeRegister b) noexcept { return vmulq_f64 (a.value, b.value); }
+    friend NativeRegister operator/ (NativeRegister a, NativeRegister b) noexcept { return vdivq_f64 (a.value, b.value); }
+    friend NativeRegister operator- (NativeRegister a) noexcept                   { return vnegq_f64 (a.value); }
+
+    friend Mask operator<  (NativeRegister a, NativeRegister b) noexcept { return { vcltq_f64 (a.value, b.value) }; }
+    friend Mask operator== (NativeRegister a, NativeRegister b) noexcept { return { vceqq_f64 (a.value, b.value) }; }
+    friend Mask operator|  (Mask a, Mask b) noexcept                     { return { vorrq_u64 (a.value, b.value) }; }
+
+    friend NativeRegister select (Mask m, NativeRegister a, NativeRegister b) noexcept
+    {
+        return vbslq_f64 (m.value, a.value, b.value);
+    }
+
+    friend NativeRegister sqrt (NativeRegister a) noexcept { return vsqrtq_f64 (a.value); }
+
+    float64x2_t value;
+};
+
+#else
+
+using NativeRegister = ScalarRegister;
+
+#endif
+
+//==============================================================================
+/** The fallback used for any easing that doesn't have a vectorised kernel:
+    it simply calls the functor for each value.
+
+    The sine, exponential and elastic families always use this. Vectorising
+    them would mean replacing the C library's sin and exp2 with polynomial
+    approximations, and those can't give the same bits as the functors, which
+    every kernel here is required to do.
+*/
+template <typename EasingType>
+struct BlockKernel
+{
+    static void process (const EasingType& easing, const double* input,
+                         double* output, int numValues) noexcept
+    {
+        for (int i = 0; i < numValues; ++i)
+            output[i] = easing (input[i]);
+    }
+};
+
+/** Base for the vectorised kernels. The derived class provides a static
+    apply() template which is run on as many full registers as possible, and
+    then on ScalarRegister for whatever is left over.
+*/
+template <typename EasingType, typename Kernel>
+struct VectorisedKernel
+{
+    static void process (const EasingType& easing, const double* input,
+                         double* output, int numValues) noexcept
+    {
+        constexpr int step = NativeRegister::size;
+
+        int i = 0;
+
+        for (; i + step <= numValues; i += step)
+            Kernel::apply (easing, NativeRegister::load (input + i)).store (output + i);
+
+        for (; i < numValues; ++i)
+            Kernel::apply (easing, ScalarRegister::load (input + i)).store (output + i);
+    }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseLinear> : VectorisedKernel<EaseLinear, BlockKernel<EaseLinear>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseLinear&, Reg t) noexcept { return t; }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseInQuad> : VectorisedKernel<EaseInQuad, BlockKernel<EaseInQuad>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInQuad&, Reg t) noexcept { return t * t; }
+};
+
+template <>
+struct BlockKernel<EaseOutQuad> : VectorisedKernel<EaseOutQuad, BlockKernel<EaseOutQuad>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutQuad&, Reg t) noexcept { return -t * (t - 2.0); }
+};
+
+template <>
+struct BlockKernel<EaseInOutQuad> : VectorisedKernel<EaseInOutQuad, BlockKernel<EaseInOutQuad>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutQuad&, Reg t) noexcept
+    {
+        t = t * 2.0;
+        const Reg u = t - 1.0;
+
+        return select (t < 1.0, t * t / 2.0, Reg (-0.5) * (u * (u - 2.0) - 1.0));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInQuad> : VectorisedKernel<EaseOutInQuad, BlockKernel<EaseOutInQuad>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInQuad&, Reg t) noexcept
+    {
+        const Reg lo = t * 2.0;
+        const Reg hi = Reg (2.0) * t - 1.0;
+
+        return select (t < 0.5, (-lo * (lo - 2.0)) / 2.0, (hi * hi) / 2.0 + 0.5);
+    }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseInCubic> : VectorisedKernel<EaseInCubic, BlockKernel<EaseInCubic>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInCubic&, Reg t) noexcept { return t * t * t; }
+};
+
+template <>
+struct BlockKernel<EaseOutCubic> : VectorisedKernel<EaseOutCubic, BlockKernel<EaseOutCubic>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutCubic&, Reg t) noexcept
+    {
+        t = t - 1.0;
+        return t * t * t + 1.0;
+    }
+};
+
+template <>
+struct BlockKernel<EaseInOutCubic> : VectorisedKernel<EaseInOutCubic, BlockKernel<EaseInOutCubic>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutCubic&, Reg t) noexcept
+    {
+        t = t * 2.0;
+        const Reg u = t - 2.0;
+
+        return select (t < 1.0, Reg (0.5) * t * t * t, Reg (0.5) * (u * u * u + 2.0));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInCubic> : VectorisedKernel<EaseOutInCubic, BlockKernel<EaseOutInCubic>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInCubic&, Reg t) noexcept
+    {
+        t = Reg (2.0) * t - 1.0;
+        const Reg cube = t * t * t;
+
+        return select (t < 0.0, (cube + 1.0) / 2.0, cube / 2.0 + 0.5);
+    }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseInQuart> : VectorisedKernel<EaseInQuart, BlockKernel<EaseInQuart>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInQuart&, Reg t) noexcept { return t * t * t * t; }
+};
+
+template <>
+struct BlockKernel<EaseOutQuart> : VectorisedKernel<EaseOutQuart, BlockKernel<EaseOutQuart>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutQuart&, Reg t) noexcept
+    {
+        t = t - 1.0;
+        return -(t * t * t * t - 1.0);
+    }
+};
+
+template <>
+struct BlockKernel<EaseInOutQuart> : VectorisedKernel<EaseInOutQuart, BlockKernel<EaseInOutQuart>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutQuart&, Reg t) noexcept
+    {
+        t = t * 2.0;
+        const Reg u = t - 2.0;
+
+        return select (t < 1.0, Reg (0.5) * t * t * t * t, Reg (-0.5) * (u * u * u * u - 2.0));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInQuart> : VectorisedKernel<EaseOutInQuart, BlockKernel<EaseOutInQuart>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInQuart&, Reg t) noexcept
+    {
+        t = Reg (2.0) * t - 1.0;
+        const Reg quart = t * t * t * t;
+
+        return select (t < 0.0, -(quart - 1.0) / 2.0, quart / 2.0 + 0.5);
+    }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseInQuint> : VectorisedKernel<EaseInQuint, BlockKernel<EaseInQuint>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInQuint&, Reg t) noexcept { return t * t * t * t * t; }
+};
+
+template <>
+struct BlockKernel<EaseOutQuint> : VectorisedKernel<EaseOutQuint, BlockKernel<EaseOutQuint>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutQuint&, Reg t) noexcept
+    {
+        t = t - 1.0;
+        return t * t * t * t * t + 1.0;
+    }
+};
+
+template <>
+struct BlockKernel<EaseInOutQuint> : VectorisedKernel<EaseInOutQuint, BlockKernel<EaseInOutQuint>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutQuint&, Reg t) noexcept
+    {
+        t = t * 2.0;
+        const Reg u = t - 2.0;
+
+        return select (t < 1.0, Reg (0.5) * t * t * t * t * t, Reg (0.5) * (u * u * u * u * u + 2.0));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInQuint> : VectorisedKernel<EaseOutInQuint, BlockKernel<EaseOutInQuint>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInQuint&, Reg t) noexcept
+    {
+        t = Reg (2.0) * t - 1.0;
+        const Reg quint = t * t * t * t * t;
+
+        return select (t < 0.0, (quint + 1.0) / 2.0, quint / 2.0 + 0.5);
+    }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseInCirc> : VectorisedKernel<EaseInCirc, BlockKernel<EaseInCirc>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInCirc&, Reg t) noexcept
+    {
+        return -(sqrt (Reg (1.0) - t * t) - 1.0);
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutCirc> : VectorisedKernel<EaseOutCirc, BlockKernel<EaseOutCirc>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutCirc&, Reg t) noexcept
+    {
+        t = t - 1.0;
+        return sqrt (Reg (1.0) - t * t);
+    }
+};
+
+template <>
+struct BlockKernel<EaseInOutCirc> : VectorisedKernel<EaseInOutCirc, BlockKernel<EaseInOutCirc>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutCirc&, Reg t) noexcept
+    {
+        t = t * 2.0;
+        const Reg u = select (t < 1.0, t, t - 2.0);
+        const Reg root = sqrt (Reg (1.0) - u * u);
+
+        return select (t < 1.0, Reg (-0.5) * (root - 1.0), Reg (0.5) * (root + 1.0));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInCirc> : VectorisedKernel<EaseOutInCirc, BlockKernel<EaseOutInCirc>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInCirc&, Reg t) noexcept
+    {
+        t = Reg (2.0) * t - 1.0;
+        const Reg root = sqrt (Reg (1.0) - t * t);
+
+        return select (t < 0.0, root / 2.0, -(root - 1.0) / 2.0 + 0.5);
+    }
+};
+
+//==============================================================================
+template <>
+struct BlockKernel<EaseInBack> : VectorisedKernel<EaseInBack, BlockKernel<EaseInBack>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInBack& e, Reg t) noexcept
+    {
+        return t * t * (Reg (e.overshoot + 1.0) * t - e.overshoot);
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutBack> : VectorisedKernel<EaseOutBack, BlockKernel<EaseOutBack>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutBack& e, Reg t) noexcept
+    {
+        t = t - 1.0;
+        return t * t * (Reg (e.overshoot + 1.0) * t + e.overshoot) + 1.0;
+    }
+};
+
+template <>
+struct BlockKernel<EaseInOutBack> : VectorisedKernel<EaseInOutBack, BlockKernel<EaseInOutBack>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutBack& e, Reg t) noexcept
+    {
+        const double s = e.overshoot * 1.525;
+
+        t = t * 2.0;
+        const Reg u = t - 2.0;
+
+        return select (t < 1.0,
+                       Reg (0.5) * (t * t * (Reg (s + 1.0) * t - s)),
+                       Reg (0.5) * (u * u * (Reg (s + 1.0) * u + s) + 2.0));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInBack> : VectorisedKernel<EaseOutInBack, BlockKernel<EaseOutInBack>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInBack& e, Reg t) noexcept
+    {
+        const double s = e.overshoot;
+
+        t = Reg (2.0) * t - 1.0;
+
+        return select (t < 0.0,
+                       (t * t * (Reg (s + 1.0) * t + s) + 1.0) / 2.0,
+                       (t * t * (Reg (s + 1.0) * t - s)) / 2.0 + 0.5);
+    }
+};
+
+//==============================================================================
+/** Branchless version of EaseOutBounce::helper(): the segment offset and
+    constant are selected per lane so every lane runs the same instructions.
+*/
+template <typename Reg>
+inline Reg bounce (Reg t, double c, double a) noexcept
+{
+    const auto inFirst  = t < 4.0 / 11.0;
+    const auto inSecond = t < 8.0 / 11.0;
+    const auto inThird  = t < 10.0 / 11.0;
+
+    const Reg shift = select (inFirst,  Reg (0.0),
+                      select (inSecond, Reg (6.0 / 11.0),
+                      select (inThird,  Reg (9.0 / 11.0), Reg (21.0 / 22.0))));
+
+    const Reg constant = select (inSecond, Reg (0.75),
+                         select (inThird,  Reg (0.9375), Reg (0.984375)));
+
+    const Reg u = select (inFirst, t, t - shift);
+    const Reg q = Reg (7.5625) * u * u;
+
+    const Reg result = select (inFirst, Reg (c) * q,
+                               Reg (-a) * (Reg (1.0) - (q + constant)) + c);
+
+    return select (t == 1.0, Reg (c), result);
+}
+
+template <>
+struct BlockKernel<EaseOutBounce> : VectorisedKernel<EaseOutBounce, BlockKernel<EaseOutBounce>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutBounce& e, Reg t) noexcept
+    {
+        return bounce (t, 1.0, e.amplitude);
+    }
+};
+
+template <>
+struct BlockKernel<EaseInBounce> : VectorisedKernel<EaseInBounce, BlockKernel<EaseInBounce>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInBounce& e, Reg t) noexcept
+    {
+        return Reg (1.0) - bounce (Reg (1.0) - t, 1.0, e.amplitude);
+    }
+};
+
+template <>
+struct BlockKernel<EaseInOutBounce> : VectorisedKernel<EaseInOutBounce, BlockKernel<EaseInOutBounce>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseInOutBounce& e, Reg t) noexcept
+    {
+        const auto inFirstHalf = t < 0.5;
+        const Reg u = select (inFirstHalf, Reg (1.0) - (Reg (2.0) * t), Reg (2.0) * t - 1.0);
+        const Reg b = bounce (u, 1.0, e.amplitude);
+
+        return select (inFirstHalf, (Reg (1.0) - b) / 2.0,
+                       select (t == 1.0, Reg (1.0), b / 2.0 + 0.5));
+    }
+};
+
+template <>
+struct BlockKernel<EaseOutInBounce> : VectorisedKernel<EaseOutInBounce, BlockKernel<EaseOutInBounce>>
+{
+    template <typename Reg>
+    static Reg apply (const EaseOutInBounce& e, Reg t) noexcept
+    {
+        const auto inFirstHalf = t < 0.5;
+        const Reg u = select (inFirstHalf, t * 2.0, Reg (2.0) - Reg (2.0) * t);
+        const Reg b = bounce (u, 0.5, e.amplitude);
+
+        return select (inFirstHalf, b, Reg (1.0) - b);
+    }
+};
+
+//==============================================================================
+/** The cubic Bezier solver can't be written as a single expression, so this
+    kernel works through the block in chunks: it seeds every value from the
+    curve's table, runs the Newton-Raphson steps on whole registers, and then
+    hands any value that didn't converge (or that needs extrapolating) back to
+    the scalar functor.
+*/
+template <>
+struct BlockKernel<EaseCubicBezier>
+{
+    static void process (const EaseCubicBezier& e, const double* input,
+                         double* output, int numValues) noexcept
+    {
+        if (e.isLinear)
+        {
+            if (input != output)
+                std::copy (input, input + numValues, output);
+
+            return;
+        }
+
+        constexpr int chunkSize = 64;
+
+        double guesses[chunkSize], errors[chunkSize], values[chunkSize];
+        bool useScalar[chunkSize];
+
+        int interval = 0;
+
+        for (int start = 0; start < numValues; start += chunkSize)
+        {
+            const int num = jmin (chunkSize, numValues - start);
+            const double* x = input + start;
+
+            for (int i = 0; i < num; ++i)
+            {
+                useScalar[i] = ! (x[i] > 0.0 && x[i] < 1.0);
+                guesses[i] = 0.5;
+
+                if (! useScalar[i])
+                {
+                    // sorted input usually stays in the same table interval
+                    interval = e.findInterval (x[i], interval);
+                    guesses[i] = e.getInitialGuess (x[i], interval);
+                    useScalar[i] = e.slopeX (guesses[i]) < EaseCubicBezier::newtonMinimumSlope;
+                }
+            }
+
+            constexpr int step = NativeRegister::size;
+
+            int i = 0;
+
+            for (; i + step <= num; i += step)
+                solve<NativeRegister> (e, x + i, guesses + i, errors + i, values + i);
+
+            for (; i < num; ++i)
+                solve<ScalarRegister> (e, x + i, guesses + i, errors + i, values + i);
+
+            for (i = 0; i < num; ++i)
+            {
+                // also catches values where the slope reached zero and produced a NaN
+                if (useScalar[i] || ! (std::abs (errors[i]) < EaseCubicBezier::precision))
+                    output[start + i] = e (x[i]);
+                else
+                    output[start + i] = values[i];
+            }
+        }
+    }
+
+    template <typename Reg>
+    static void solve (const EaseCubicBezier& e, const double* input, const double* guesses,
+                       double* errors, double* values) noexcept
+    {
+        const Reg x = Reg::load (input);
+        const Reg ax (e.ax), bx (e.bx), cx (e.cx);
+        const Reg ax3 (3.0 * e.ax), bx2 (2.0 * e.bx);
+
+        Reg t = Reg::load (guesses);
+
+        for (int i = 0; i < EaseCubicBezier::newtonIterations; ++i)
+            t = t - (((ax * t + bx) * t + cx) * t - x) / ((ax3 * t + bx2) * t + cx);
+
+        (((ax * t + bx) * t + cx) * t - x).store (errors);
+        (((Reg (e.ay) * t + Reg (e.by)) * t + Reg (e.cy)) * t).store (values);
+    }
+};
+
+} // namespace SIMDDetail
+
+//==============================================================================
+/** Applies an easing function to a block of values.
+
+    This is equivalent to calling the easing's operator() for each value, but
+    the polynomial, circular, back and bounce families are evaluated several
+    values at a time using SSE2, AVX2 or NEON (depending on what the target was
+    compiled for), with the piecewise curves evaluated branchlessly. The cubic
+    Bezier curve runs its Newton-Raphson steps several values at a time. The
+    sine, exponential and elastic families, and any easing type that isn't
+    part of this module, use a plain loop over operator(). For the
+    transcendental families that's permanent rather than a gap to be filled,
+    because only the C library's sin and exp2 give the same results as the
+    functors (see SIMDDetail::BlockKernel).
+
+    The vectorised kernels perform exactly the same floating point operations
+    as the scalar functors, so results are bit-identical, except when the
+    compiler is allowed to contract the scalar code into fused multiply-adds
+    (e.g. -ffp-contract=fast with FMA enabled). In that case results can differ
+    by a few ULP, which for inputs in [0, 1] stays below 1.0e-15.
+
+    The input and output may point to the same buffer.
+
+    @see JUCE_ANIMATION_DISABLE_SIMD
+*/
+template <typename EasingType>
+inline void processBlock (const EasingType& easing, const double* input,
+                          double* output, int numValues) noexcept
+{
+    SIMDDetail::BlockKernel<EasingType>::process (easing, input, output, numValues);
+}
+
+}
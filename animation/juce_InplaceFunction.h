@@ -0,0 +1,184 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+template <typename Signature, size_t capacity = 64>
+class InplaceFunction;
+
+//==============================================================================
+/**
+    A copyable function wrapper, like std::function, that always stores its
+    callable inside the object itself and so never allocates.
+
+    Callables larger than the capacity are rejected at compile time, rather
+    than being moved to the heap. The default capacity fits a lambda capturing
+    several pointers or values, or a std::function (which is copied as it is,
+    so copying one that holds a large target will still allocate).
+
+    This is what AnimationEngine::Options uses for its callbacks, so that
+    starting and stopping animations doesn't touch the heap.
+*/
+template <typename Result, typename... Args, size_t capacity>
+class InplaceFunction<Result (Args...), capacity>
+{
+public:
+    //==============================================================================
+    /** Creates an empty function. */
+    InplaceFunction() noexcept = default;
+
+    /** Creates an empty function. */
+    InplaceFunction (std::nullptr_t) noexcept {}
+
+    /** Creates a function holding a copy of a callable. */
+    template <typename Callable,
+              typename = std::enable_if_t<! std::is_same<std::decay_t<Callable>, InplaceFunction>::value>>
+    InplaceFunction (Callable&& callable)
+    {
+        using Stored = std::decay_t<Callable>;
+
+        static_assert (sizeof (Stored) <= capacity,
+                       "This callable is too large for the InplaceFunction's capacity");
+        static_assert (alignof (Stored) <= alignof (std::max_align_t),
+                       "This callable is over-aligned for an InplaceFunction");
+
+        if (isEmpty (callable))
+            return;
+
+        new (storage) Stored (std::forward<Callable> (callable));
+        ops = &Operations<Stored>::table;
+    }
+
+    InplaceFunction (const InplaceFunction& other)
+        : ops (other.ops)
+    {
+        if (ops != nullptr)
+            ops->copy (storage, other.storage);
+    }
+
+    InplaceFunction (InplaceFunction&& other) noexcept
+        : ops (other.ops)
+    {
+        if (ops != nullptr)
+            ops->move (storage, other.storage);
+
+        other.ops = nullptr;
+    }
+
+    InplaceFunction& operator= (const InplaceFunction& other)
+    {
+        if (this != &other)
+        {
+            reset();
+
+            if (other.ops != nullptr)
+                other.ops->copy (storage, other.storage);
+
+            ops = other.ops;
+        }
+
+        return *this;
+    }
+
+    InplaceFunction& operator= (InplaceFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+
+            if (other.ops != nullptr)
+                other.ops->move (storage, other.storage);
+
+            ops = other.ops;
+            other.ops = nullptr;
+        }
+
+        return *this;
+    }
+
+    InplaceFunction& operator= (std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction()
+    {
+        reset();
+    }
+
+    //==============================================================================
+    /** Calls the function. It mustn't be empty. */
+    Result operator() (Args... args) const
+    {
+        jassert (ops != nullptr);
+        return ops->call (storage, std::forward<Args> (args)...);
+    }
+
+    /** Returns true if the function isn't empty. */
+    explicit operator bool() const noexcept                         { return ops != nullptr; }
+
+    friend bool operator== (const InplaceFunction& f, std::nullptr_t) noexcept { return f.ops == nullptr; }
+    friend bool operator!= (const InplaceFunction& f, std::nullptr_t) noexcept { return f.ops != nullptr; }
+
+private:
+    //==============================================================================
+    struct Table
+    {
+        Result (*call) (void*, Args...);
+        void (*copy) (void*, const void*);
+        void (*move) (void*, void*) noexcept;
+        void (*destroy) (void*) noexcept;
+    };
+
+    template <typename Stored>
+    struct Operations
+    {
+        static Result call (void* s, Args... args)          { return (*static_cast<Stored*> (s)) (std::forward<Args> (args)...); }
+        static void copy (void* d, const void* s)           { new (d) Stored (*static_cast<const Stored*> (s)); }
+        static void move (void* d, void* s) noexcept        { new (d) Stored (std::move (*static_cast<Stored*> (s))); destroy (s); }
+        static void destroy (void* s) noexcept              { static_cast<Stored*> (s)->~Stored(); }
+
+        static constexpr Table table { call, copy, move, destroy };
+    };
+
+    void reset() noexcept
+    {
+        if (ops != nullptr)
+            ops->destroy (storage);
+
+        ops = nullptr;
+    }
+
+    template <typename Callable>
+    static bool isEmpty (const Callable&) noexcept                  { return false; }
+
+    template <typename R, typename... A>
+    static bool isEmpty (R (*fn) (A...)) noexcept                   { return fn == nullptr; }
+
+    template <typename S>
+    static bool isEmpty (const std::function<S>& fn) noexcept       { return fn == nullptr; }
+
+    //==============================================================================
+    alignas (std::max_align_t) mutable char storage[capacity];
+    const Table* ops = nullptr;
+};
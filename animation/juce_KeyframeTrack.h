@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    A sequence of values at points in time, with an easing curve for each
+    segment between them.
+
+    Each keyframe holds a time, a value, and the easing used to move from that
+    value to the value of the next keyframe. Before the first keyframe the track
+    holds the first value, and after the last one it holds the last value.
+
+    The keyframes are kept sorted in a single contiguous array. Evaluating the
+    track remembers the segment that was used last, so playing forwards (or
+    backwards) through the track finds each segment in constant time, and only
+    a jump to a distant time falls back to a binary search. Evaluating never
+    allocates.
+
+    The value type needs to support `a + (b - a) * proportion`, which covers
+    float, double and Point.
+
+    @code
+    KeyframeTrack<double> track;
+    track.addKeyframe (0.0, 0.0,   EasingFunctions::EaseOutCubic());
+    track.addKeyframe (0.5, 100.0, EasingFunctions::EaseInOutSine());
+    track.addKeyframe (2.0, 40.0);
+
+    for (double t = 0.0; t < 2.0; t += 1.0 / 60.0)
+        component.setTopLeftPosition (0, (int) track.getValueAt (t));
+    @endcode
+
+    Because of the cached segment, a track shouldn't be evaluated from more
+    than one thread at a time.
+
+    @see AnimatedPositionBehaviours::Keyframed
+*/
+template <typename ValueType, typename EasingFunction = EasingFunctions::AnyEasing>
+class KeyframeTrack
+{
+public:
+    //==============================================================================
+    /** A single point on the track. */
+    struct Keyframe
+    {
+        /** The time of the keyframe in seconds. */
+        double time = 0.0;
+
+        /** The value of the track at this keyframe. */
+        ValueType value {};
+
+        /** The curve used between this keyframe and the next one. */
+        EasingFunction easing {};
+    };
+
+    //==============================================================================
+    /** Creates an empty track. */
+    KeyframeTrack() = default;
+
+    /** Adds a keyframe, keeping the keyframes sorted by time. A keyframe added
+        at the same time as an existing one goes after it, making a jump in
+        value at that time.
+
+        @returns the index at which the keyframe was inserted
+    */
+    int addKeyframe (double time, const ValueType& value, const EasingFunction& easing = {})
+    {
+        const auto index = (int) (std::upper_bound (keyframes.begin(), keyframes.end(), time,
+                                                    [] (double t, const Keyframe& k) { return t < k.time; })
+                                    - keyframes.begin());
+
+        keyframes.insert (index, { time, value, easing });
+        cursor = 0;
+        return index;
+    }
+
+    /** Removes the keyframe at an index. */
+    void removeKeyframe (int index)
+    {
+        keyframes.remove (index);
+        cursor = 0;
+    }
+
+    /** Removes all keyframes. */
+    void clear()
+    {
+        keyframes.clearQuick();
+        cursor = 0;
+    }
+
+    /** Preallocates space for a number of keyframes. */
+    void ensureStorageAllocated (int numKeyframes)
+    {
+        keyframes.ensureStorageAllocated (numKeyframes);
+    }
+
+    //==============================================================================
+    /** Returns the number of keyframes. */
+    int getNumKeyframes() const noexcept                { return keyframes.size(); }
+
+    /** Returns a keyframe, in time order. */
+    const Keyframe& getKeyframe (int index) const noexcept
+    {
+        jassert (isPositiveAndBelow (index, keyframes.size()));
+        return keyframes.getReference (index);
+    }
+
+    /** Returns the time of the first keyframe, or 0 if the track is empty. */
+    double getStartTime() const noexcept                { return keyframes.isEmpty() ? 0.0 : keyframes.getReference (0).time; }
+
+    /** Returns the time of the last keyframe, or 0 if the track is empty. */
+    double getEndTime() const noexcept                  { return keyframes.isEmpty() ? 0.0 : keyframes.getReference (keyframes.size() - 1).time; }
+
+    /** Returns the time between the first and last keyframes. */
+    double getDuration() const noexcept                 { return getEndTime() - getStartTime(); }
+
+    //==============================================================================
+    /** Returns the value of the track at a time in seconds. If the track is
+        empty this returns a default-constructed value.
+    */
+    ValueType getValueAt (double time) const noexcept
+    {
+        const int numKeyframes = keyframes.size();
+
+        if (numKeyframes == 0)
+            return {};
+
+        const auto* k = keyframes.begin();
+
+        if (numKeyframes == 1 || time <= k[0].time)
+            return k[0].value;
+
+        if (time >= k[numKeyframes - 1].time)
+            return k[numKeyframes - 1].value;
+
+        const int index = getSegmentIndex (time);
+        const auto& from = k[index];
+        const auto& to   = k[index + 1];
+
+        const double proportion = (time - from.time) / (to.time - from.time);
+        return from.value + (to.value - from.value) * from.easing (proportion);
+    }
+
+    /** Returns the index of the keyframe that starts the segment containing a
+        time, clamped to the segments that exist. The result is remembered and
+        checked first on the next call.
+    */
+    int getSegmentIndex (double time) const noexcept
+    {
+        const int lastSegment = keyframes.size() - 2;
+
+        if (lastSegment < 0)
+            return 0;
+
+        const auto* k = keyframes.begin();
+        const int c = jmin (cursor, lastSegment);
+
+        if (time >= k[c].time)
+        {
+            if (time < k[c + 1].time || c == lastSegment)
+                return c;
+
+            // the usual case when playing forwards
+            if (c + 1 == lastSegment || time < k[c + 2].time)
+                return cursor = c + 1;
+        }
+        else if (c > 0 && time >= k[c - 1].time)
+        {
+            // the usual case when playing backwards
+            return cursor = c - 1;
+        }
+
+        return cursor = findSegment (time);
+    }
+
+private:
+    //==============================================================================
+    int findSegment (double time) const noexcept
+    {
+        // the last keyframe whose time is <= time, with equal times resolving to
+        // the later keyframe so that jumps in value happen at the keyframe time
+        const auto* first = keyframes.begin();
+        const auto* last  = keyframes.end() - 1;
+
+        const auto* upper = std::upper_bound (first, last, time,
+                                              [] (double t, const Keyframe& k) { return t < k.time; });
+
+        return jlimit (0, keyframes.size() - 2, (int) (upper - first) - 1);
+    }
+
+    Array<Keyframe> keyframes;
+    mutable int cursor = 0;
+};
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+ManualAnimationClock::ManualAnimationClock (double framesPerSecond)
+    : frameRate (framesPerSecond)
+{
+    jassert (frameRate > 0.0);
+}
+
+ManualAnimationClock::~ManualAnimationClock() = default;
+
+//==============================================================================
+void ManualAnimationClock::attach (AnimationEngine& engine)
+{
+    engine.setTimerEnabled (false);
+    engine.setEvaluation (AnimationEngine::Evaluation::messageThread);
+
+    attach ([&engine] (double delta) { engine.tick (delta); });
+}
+
+void ManualAnimationClock::attach (AnimationTimeline& timeline)
+{
+    // evaluated at the clock's time rather than stepped, so that rounding
+    // doesn't build up over a long render
+    timeline.evaluate (getTime());
+    attach ([this, &timeline] (double) { timeline.evaluate (getTime()); });
+}
+
+#if JUCE_MODULE_AVAILABLE_juce_gui_basics
+void ManualAnimationClock::attach (ComponentPropertyAnimator& animator)
+{
+    animator.setTimerEnabled (false);
+    attach ([&animator] (double delta) { animator.tick (delta); });
+}
+#endif
+
+void ManualAnimationClock::attach (Callback callback)
+{
+    jassert (callback != nullptr);
+
+    // adding to callbacks now could reallocate it under the callback that's running
+    if (isTicking)
+        attachedWhileTicking.push_back (std::move (callback));
+    else
+        callbacks.push_back (std::move (callback));
+}
+
+//==============================================================================
+void ManualAnimationClock::advance (int numFrames)
+{
+    jassert (numFrames >= 0);
+
+    const double delta = 1.0 / frameRate;
+
+    for (int i = 0; i < numFrames; ++i)
+    {
+        ++frame;
+
+        isTicking = true;
+
+        for (auto& callback : callbacks)
+            callback (delta);
+
+        isTicking = false;
+
+        for (auto& callback : attachedWhileTicking)
+            callbacks.push_back (std::move (callback));
+
+        attachedWhileTicking.clear();
+    }
+}
+
+void ManualAnimationClock::advanceToFrame (int64 targetFrame)
+{
+    jassert (targetFrame >= frame);
+
+    while (frame < targetFrame)
+        advance (1);
+}
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    A clock that only moves when it's told to, in exact steps of one frame.
+
+    Attaching an AnimationEngine, ComponentPropertyAnimator or AnimationTimeline
+    turns off its own timer, and from then on it's ticked by advance() instead
+    of by the wall clock. Every tick is exactly one frame long however long it
+    actually takes, so the same sequence of calls always produces the same
+    animation. That makes it possible to render animations headless and faster
+    than real time, as OfflineAnimationRenderer does, or to check them frame by
+    frame in tests.
+
+    @code
+    ManualAnimationClock clock (30.0);
+    clock.attach (engine);
+    clock.attach ([&] (double delta) { position = behaviour.getNextPosition (position, delta); });
+
+    for (int i = 0; i < 90; ++i)
+    {
+        clock.advance();
+        checkFrame (clock.getFrame(), engine.getValue (id), position);
+    }
+    @endcode
+
+    Anything attached must outlive the clock, or at least its last call to
+    advance().
+*/
+class ManualAnimationClock
+{
+public:
+    //==============================================================================
+    /** Creates a clock at frame zero, ticking at the given rate. */
+    explicit ManualAnimationClock (double framesPerSecond = 60.0);
+
+    /** Destructor. */
+    ~ManualAnimationClock();
+
+    //==============================================================================
+    /** Called on each frame with the length of a frame in seconds. */
+    using Callback = std::function<void (double deltaSeconds)>;
+
+    /** Ticks an engine on every frame. This turns off the engine's timer, and
+        switches it to Evaluation::messageThread, because values evaluated in
+        the background lag by an amount that depends on thread timing.
+    */
+    void attach (AnimationEngine& engine);
+
+    /** Evaluates a timeline at the clock's time on every frame. */
+    void attach (AnimationTimeline& timeline);
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    /** Ticks an animator on every frame, turning off the animator's timer. */
+    void attach (ComponentPropertyAnimator& animator);
+   #endif
+
+    /** Calls a function on every frame, e.g. to step an Eased behaviour.
+
+        Anything attached from inside a callback is first called on the frame
+        after the one being ticked.
+    */
+    void attach (Callback callback);
+
+    //==============================================================================
+    /** Moves forward by a number of frames, ticking everything attached once
+        per frame, in the order they were attached.
+    */
+    void advance (int numFrames = 1);
+
+    /** Moves forward to a frame. A clock can't go backwards, so to get to an
+        earlier frame, start again with a fresh clock and fresh animations.
+    */
+    void advanceToFrame (int64 targetFrame);
+
+    /** Returns the number of frames the clock has moved. */
+    int64 getFrame() const noexcept                     { return frame; }
+
+    /** Returns the time of the current frame in seconds. */
+    double getTime() const noexcept                     { return (double) frame / frameRate; }
+
+    /** Returns the number of frames per second. */
+    double getFrameRate() const noexcept                { return frameRate; }
+
+private:
+    //==============================================================================
+    double frameRate;
+    int64 frame = 0;
+    std::vector<Callback> callbacks, attachedWhileTicking;
+    bool isTicking = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ManualAnimationClock)
+};
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+OfflineAnimationRenderer::OfflineAnimationRenderer (SceneFactory sceneFactory)
+    : createScene (std::move (sceneFactory))
+{
+    jassert (createScene != nullptr);
+}
+
+OfflineAnimationRenderer::~OfflineAnimationRenderer() = default;
+
+//==============================================================================
+void OfflineAnimationRenderer::render (const Options& options, const FrameCallback& frameCallback)
+{
+    jassert (frameCallback != nullptr);
+
+    if (options.numFrames <= 0 || createScene == nullptr)
+        return;
+
+    const int numThreads = options.numThreads > 0 ? options.numThreads : SystemStats::getNumCpus();
+    const int64 framesPerJob = options.framesPerJob > 0 ? (int64) options.framesPerJob
+                                                        : (options.numFrames + numThreads - 1) / numThreads;
+    const int64 numJobs = (options.numFrames + framesPerJob - 1) / framesPerJob;
+
+    std::atomic<int64> jobsRemaining { numJobs };
+    WaitableEvent finished;
+
+    {
+        ThreadPool pool (jmax (1, (int) jmin ((int64) numThreads, numJobs)));
+
+        for (int64 job = 0; job < numJobs; ++job)
+        {
+            const auto start = options.firstFrame + job * framesPerJob;
+            const auto end = jmin (start + framesPerJob, options.firstFrame + options.numFrames);
+
+            pool.addJob ([this, &options, &frameCallback, &jobsRemaining, &finished, start, end]
+            {
+                renderRange (options, start, end, frameCallback);
+
+                if (--jobsRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        finished.wait();
+    }
+}
+
+void OfflineAnimationRenderer::renderRange (const Options& options, int64 start, int64 end,
+                                            const FrameCallback& frameCallback) const
+{
+    ManualAnimationClock clock (options.frameRate);
+    const auto scene = createScene (clock);
+
+    if (scene == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    // stepping rather than jumping, so that every job sees exactly the same
+    // sequence of ticks up to its first frame
+    clock.advanceToFrame (start);
+
+    for (auto frame = start; frame < end; ++frame)
+    {
+        if (frame > start)
+            clock.advance();
+
+        scene->prepareFrame (frame);
+
+        auto& component = scene->getComponent();
+        frameCallback (frame, component.createComponentSnapshot (component.getLocalBounds(), true, options.scale));
+    }
+}
+
+//==============================================================================
+Result OfflineAnimationRenderer::renderToImageSequence (const Options& options, const File& directory,
+                                                        const String& filenamePrefix)
+{
+    const auto created = directory.createDirectory();
+
+    if (! created.wasOk())
+        return created;
+
+    const int numDigits = jmax (6, String (options.firstFrame + options.numFrames - 1).length());
+
+    CriticalSection errorLock;
+    String error;
+
+    render (options, [&] (int64 frame, const Image& image)
+    {
+        const auto file = directory.getChildFile (filenamePrefix + String (frame).paddedLeft ('0', numDigits) + ".png");
+        file.deleteFile();
+
+        FileOutputStream stream (file);
+        PNGImageFormat png;
+
+        if (stream.openedOk() && png.writeImageToStream (image, stream))
+            return;
+
+        const ScopedLock sl (errorLock);
+
+        if (error.isEmpty())
+            error = "Couldn't write " + file.getFullPathName();
+    });
+
+    return error.isEmpty() ? Result::ok() : Result::fail (error);
+}
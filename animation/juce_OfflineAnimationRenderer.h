@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+/**
+    Renders an animated component to images, frame by frame, headless and
+    faster than real time.
+
+    The animations are driven by a ManualAnimationClock, so frame n always
+    shows the state after exactly n ticks of 1 / frameRate seconds, however
+    long each frame takes to paint. Because of that, separate ranges of frames
+    can be rendered independently: the frames are split into jobs which run on
+    a ThreadPool, and each job builds its own copy of the scene, steps its
+    clock to the first frame of its range without painting, and then renders
+    the range. The output is identical whichever thread renders each frame.
+
+    @code
+    struct PanelScene  : public OfflineAnimationRenderer::Scene
+    {
+        PanelScene (ManualAnimationClock& clock)
+        {
+            root.setSize (800, 600);
+            root.addAndMakeVisible (panel);
+            clock.attach (animator);
+            animator.animateBounds (panel, { 0, 0, 400, 600 }, timing);
+        }
+
+        Component& getComponent() override      { return root; }
+
+        Component root;
+        PanelView panel;
+        ComponentPropertyAnimator animator;
+    };
+
+    OfflineAnimationRenderer renderer ([] (ManualAnimationClock& clock)
+    {
+        return std::make_unique<PanelScene> (clock);
+    });
+
+    OfflineAnimationRenderer::Options options;
+    options.frameRate = 60.0;
+    options.numFrames = 300;
+
+    const auto result = renderer.renderToImageSequence (options, outputDirectory);
+    @endcode
+
+    Scenes are created and painted on the pool's threads. JUCE allows this for
+    components that aren't on the desktop, but anything a scene shares with
+    the rest of the app (look-and-feels, images, fonts loaded from memory)
+    must be safe to use from several threads at once. The clock only moves by
+    exact frames, so scenes should use animation classes that can be attached
+    to one, or be stepped from a ManualAnimationClock::Callback, rather than
+    anything with a timer of its own.
+*/
+class OfflineAnimationRenderer
+{
+public:
+    //==============================================================================
+    /** One copy of the content being rendered. */
+    class Scene
+    {
+    public:
+        /** Destructor. */
+        virtual ~Scene() = default;
+
+        /** Returns the component to capture. It mustn't be on the desktop. */
+        virtual Component& getComponent() = 0;
+
+        /** Called just before each frame is captured, once the clock has moved
+            to it, for anything that needs updating that isn't attached to the
+            clock.
+        */
+        virtual void prepareFrame (int64 frame)         { ignoreUnused (frame); }
+    };
+
+    /** Creates a new copy of the scene, with its animations attached to a
+        clock at frame zero. This is called on the pool's threads, once per
+        job, and every scene it creates must start out the same.
+    */
+    using SceneFactory = std::function<std::unique_ptr<Scene> (ManualAnimationClock&)>;
+
+    /** Called with each rendered frame, from the pool's threads and in no
+        particular order.
+    */
+    using FrameCallback = std::function<void (int64 frame, const Image& image)>;
+
+    /** Which frames to render, and how. */
+    struct Options
+    {
+        /** The number of frames per second of animation time. */
+        double frameRate = 60.0;
+
+        /** The range of frames to render. */
+        int64 firstFrame = 0, numFrames = 0;
+
+        /** The scale of the images relative to the component's size. */
+        float scale = 1.0f;
+
+        /** The number of threads to render on, or 0 for one per CPU core. */
+        int numThreads = 0;
+
+        /** The number of consecutive frames in each job, or 0 to give each
+            thread one range. Smaller jobs balance the load better when some
+            frames are much slower to paint than others, but each job has to
+            step a fresh scene up to its first frame.
+        */
+        int framesPerJob = 0;
+    };
+
+    //==============================================================================
+    /** Creates a renderer for the scenes made by a factory. */
+    explicit OfflineAnimationRenderer (SceneFactory sceneFactory);
+
+    /** Destructor. */
+    ~OfflineAnimationRenderer();
+
+    //==============================================================================
+    /** Renders frames and passes them to a callback, returning once they've
+        all been rendered.
+    */
+    void render (const Options& options, const FrameCallback& frameCallback);
+
+    /** Renders frames to a sequence of PNG files in a directory, named with a
+        prefix followed by the zero-padded frame number, e.g. "frame_000042.png".
+        Existing files with the same names are replaced.
+    */
+    Result renderToImageSequence (const Options& options, const File& directory,
+                                  const String& filenamePrefix = "frame_");
+
+private:
+    //==============================================================================
+    void renderRange (const Options& options, int64 start, int64 end, const FrameCallback& frameCallback) const;
+
+    SceneFactory createScene;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineAnimationRenderer)
+};
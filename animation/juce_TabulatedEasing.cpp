@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+namespace EasingFunctions
+{
+
+namespace
+{
+    struct EasingTableCache
+    {
+        struct Entry
+        {
+            EasingTable::CurveKey key;
+            int numSamples;
+            EasingTable::Interpolation interpolation;
+            EasingTable::Ptr table;
+        };
+
+        /** Drops any tables that are no longer used by anything but the cache. */
+        void purgeUnused()
+        {
+            for (int i = entries.size(); --i >= 0;)
+                if (entries.getReference (i).table->getReferenceCount() == 1)
+                    entries.remove (i);
+        }
+
+        CriticalSection lock;
+        Array<Entry> entries;
+    };
+
+    EasingTableCache& getEasingTableCache()
+    {
+        static EasingTableCache cache;
+        return cache;
+    }
+}
+
+//==============================================================================
+EasingTable::EasingTable (int size, Interpolation interp, const std::function<double(double)>& curve)
+    : numSamples (size), interpolation (interp)
+{
+    jassert (numSamples >= 2);
+
+    // one extra sample at each end, so the cubic spline always has four points
+    samples.malloc ((size_t) numSamples + 2);
+
+    for (int i = 0; i < numSamples; ++i)
+        samples[(size_t) i + 1] = curve ((double) i / (numSamples - 1));
+
+    // the end points are extrapolated linearly rather than sampled, because
+    // some curves aren't defined outside [0, 1]
+    samples[0] = 2.0 * samples[1] - samples[2];
+    samples[(size_t) numSamples + 1] = 2.0 * samples[(size_t) numSamples] - samples[(size_t) numSamples - 1];
+
+    constexpr int pointsPerInterval = 16;
+    const int numPoints = (numSamples - 1) * pointsPerInterval;
+
+    for (int i = 0; i <= numPoints; ++i)
+    {
+        const double t = (double) i / numPoints;
+        maximumError = jmax (maximumError, std::abs (evaluate (t) - curve (t)));
+    }
+}
+
+EasingTable::Ptr EasingTable::getOrCreate (const CurveKey& key,
+                                           int numSamples,
+                                           Interpolation interpolation,
+                                           const std::function<double(double)>& curve)
+{
+    numSamples = jmax (2, numSamples);
+
+    auto& cache = getEasingTableCache();
+    const ScopedLock sl (cache.lock);
+
+    for (auto& entry : cache.entries)
+    {
+        if (entry.numSamples == numSamples
+             && entry.interpolation == interpolation
+             && entry.key == key)
+        {
+            return entry.table;
+        }
+    }
+
+    cache.purgeUnused();
+
+    Ptr table (new EasingTable (numSamples, interpolation, curve));
+    cache.entries.add ({ key, numSamples, interpolation, table });
+
+    return table;
+}
+
+EasingTable::Ptr EasingTable::create (int numSamples,
+                                      Interpolation interpolation,
+                                      const std::function<double(double)>& curve)
+{
+    return new EasingTable (jmax (2, numSamples), interpolation, curve);
+}
+
+int EasingTable::getNumCachedTables()
+{
+    auto& cache = getEasingTableCache();
+    const ScopedLock sl (cache.lock);
+
+    cache.purgeUnused();
+    return cache.entries.size();
+}
+
+}
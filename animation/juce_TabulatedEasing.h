@@ -0,0 +1,400 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace EasingFunctions
+{
+
+//==============================================================================
+/** A set of evenly spaced samples of an easing curve over the range [0, 1].
+
+    Tables are immutable once built. Those made with getOrCreate() are shared
+    between all the TabulatedEasing objects that sample a curve with the same
+    key, size and interpolation mode.
+
+    @see TabulatedEasing
+*/
+class EasingTable  : public ReferenceCountedObject
+{
+public:
+    using Ptr = ReferenceCountedObjectPtr<EasingTable>;
+
+    /** The method used to evaluate the curve between two samples. */
+    enum class Interpolation
+    {
+        linear,     /**< Straight lines between samples. */
+        cubic       /**< A Catmull-Rom spline through the samples. */
+    };
+
+    /** Identifies a curve in the cache. Curves with the same key share a table,
+        so two curves must only be given the same key if they are identical.
+    */
+    struct CurveKey
+    {
+        /** A name that uniquely identifies the curve type, or the curve. */
+        String name;
+
+        /** Everything else that the curve depends on. */
+        std::array<double, maxNumEasingParameters> parameters {};
+
+        bool operator== (const CurveKey& other) const noexcept
+        {
+            return name == other.name && parameters == other.parameters;
+        }
+    };
+
+    //==============================================================================
+    /** Returns a table for the given curve, creating one if there isn't already
+        a matching table in the cache.
+
+        @param key              identifies the curve being sampled
+        @param numSamples       the number of samples in the table (minimum 2)
+        @param interpolation    the interpolation to use between samples
+        @param curve            the function to sample if a table has to be built
+    */
+    static Ptr getOrCreate (const CurveKey& key,
+                            int numSamples,
+                            Interpolation interpolation,
+                            const std::function<double(double)>& curve);
+
+    /** Creates a table for the given curve which isn't added to the cache. */
+    static Ptr create (int numSamples,
+                       Interpolation interpolation,
+                       const std::function<double(double)>& curve);
+
+    /** Returns the number of tables currently held by the cache. */
+    static int getNumCachedTables();
+
+    //==============================================================================
+    /** Evaluates the tabulated curve at a position in [0, 1]. Positions outside
+        this range are clamped.
+    */
+    double evaluate (double t) const noexcept
+    {
+        const double x = jlimit (0.0, 1.0, t) * (numSamples - 1);
+        const int index = jmin ((int) x, numSamples - 2);
+        const double f = x - index;
+
+        // samples are offset by one so that the cubic spline can read index - 1
+        const double* p = samples.get() + index;
+
+        if (interpolation == Interpolation::linear)
+            return p[1] + f * (p[2] - p[1]);
+
+        return p[1] + 0.5 * f * (p[2] - p[0]
+                                 + f * (2.0 * p[0] - 5.0 * p[1] + 4.0 * p[2] - p[3]
+                                        + f * (3.0 * (p[1] - p[2]) + p[3] - p[0])));
+    }
+
+    /** Returns the slope of the tabulated curve at a position in [0, 1]. */
+    double evaluateDerivative (double t) const noexcept
+    {
+        const double x = jlimit (0.0, 1.0, t) * (numSamples - 1);
+        const int index = jmin ((int) x, numSamples - 2);
+        const double f = x - index;
+        const double* p = samples.get() + index;
+
+        if (interpolation == Interpolation::linear)
+            return (p[2] - p[1]) * (numSamples - 1);
+
+        return 0.5 * (numSamples - 1) * (p[2] - p[0]
+                                         + f * (2.0 * (2.0 * p[0] - 5.0 * p[1] + 4.0 * p[2] - p[3])
+                                                + f * 3.0 * (3.0 * (p[1] - p[2]) + p[3] - p[0])));
+    }
+
+    /** Returns the number of samples in the table. */
+    int getNumSamples() const noexcept                  { return numSamples; }
+
+    /** Returns the interpolation mode used between samples. */
+    Interpolation getInterpolation() const noexcept     { return interpolation; }
+
+    /** Returns the largest absolute difference between the tabulated curve and
+        the original curve, measured at several points between each pair of
+        samples when the table was built.
+    */
+    double getMaximumError() const noexcept             { return maximumError; }
+
+private:
+    EasingTable (int numSamples, Interpolation, const std::function<double(double)>& curve);
+
+    HeapBlock<double> samples;
+    int numSamples;
+    Interpolation interpolation;
+    double maximumError = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EasingTable)
+};
+
+//==============================================================================
+/** Wraps one of the EasingFunctions types (or any other easing functor) and
+    evaluates it from a precomputed table instead of calling it directly.
+
+    This is useful for the curves which are expensive to compute, such as the
+    elastic family (pow, sin and asin on every call) or the bounce family. The
+    table is built the first time a particular curve is used, including its
+    amplitude/period/overshoot parameters, and then shared through a cache by
+    every TabulatedEasing with the same curve, size and interpolation.
+
+    Only curves whose type and parameters say everything about them are shared
+    that way: the types in this namespace, an AnyEasing, and types without any
+    data members. Anything else, such as a std::function, a capturing lambda or
+    a combinator, gets a table of its own unless it's given a cache key.
+
+    @code
+    AnimatedPosition<AnimatedPositionBehaviours::Eased<TabulatedEasing<EaseOutElastic>>> pos;
+    pos.behaviour.easing = TabulatedEasing<EaseOutElastic> ({ 1.0, 0.3 }, 512);
+
+    DBG (pos.behaviour.easing.getMaximumError());
+    @endcode
+*/
+template <typename EasingType>
+class TabulatedEasing
+{
+public:
+    /** Creates a table of the default-constructed curve. */
+    TabulatedEasing()
+        : TabulatedEasing (EasingType())
+    {
+    }
+
+    /** Creates (or fetches from the cache) a table of the given curve. The
+        cache is only used for types that it can tell apart; see above.
+    */
+    explicit TabulatedEasing (const EasingType& curveToSample,
+                              int numSamples = 256,
+                              EasingTable::Interpolation interpolation = EasingTable::Interpolation::cubic)
+        : curve (curveToSample)
+    {
+        if constexpr (canBeIdentified)
+            table = EasingTable::getOrCreate (getCurveKey (curve), numSamples, interpolation, curve);
+        else
+            table = EasingTable::create (numSamples, interpolation, curve);
+    }
+
+    /** Creates (or fetches from the cache) a table of the given curve, shared
+        with any other curve of this type which uses the same cache key. This
+        is for curves that the cache can't tell apart by itself, so it's up to
+        the caller to only use the same key for identical curves.
+    */
+    TabulatedEasing (const EasingType& curveToSample,
+                     const String& cacheKey,
+                     int numSamples = 256,
+                     EasingTable::Interpolation interpolation = EasingTable::Interpolation::cubic)
+        : curve (curveToSample)
+    {
+        table = EasingTable::getOrCreate ({ typeid (EasingType).name() + String ("/") + cacheKey },
+                                          numSamples, interpolation, curve);
+    }
+
+    /** Evaluates the curve. Positions inside [0, 1] come from the table, and
+        anything outside is passed on to the original curve.
+    */
+    double operator() (double t) const noexcept
+    {
+        if (t < 0.0 || t > 1.0)
+            return curve (t);
+
+        return table->evaluate (t);
+    }
+
+    /** Returns the slope of the curve, using the table inside [0, 1] so that it
+        matches the values returned by operator().
+    */
+    double derivative (double t) const noexcept
+    {
+        if (t < 0.0 || t > 1.0)
+            return getDerivative (curve, t);
+
+        return table->evaluateDerivative (t);
+    }
+
+    /** Returns the curve that was sampled. */
+    const EasingType& getCurve() const noexcept         { return curve; }
+
+    /** Returns the table being used. */
+    const EasingTable& getTable() const noexcept        { return *table; }
+
+    /** Returns the largest absolute error of the table against the curve. */
+    double getMaximumError() const noexcept             { return table->getMaximumError(); }
+
+private:
+    static constexpr bool canBeIdentified = IsAnyEasingAlternative<EasingType>::value
+                                             || std::is_same<EasingType, AnyEasing>::value
+                                             || std::is_empty<EasingType>::value;
+
+    static EasingTable::CurveKey getCurveKey (const EasingType& curveToSample)
+    {
+        EasingTable::CurveKey key;
+
+        if constexpr (std::is_same<EasingType, AnyEasing>::value)
+        {
+            // keyed by the type being held, so that it shares tables with that type
+            key.name = curveToSample.visit ([] (const auto& e) { return typeid (e).name(); });
+            curveToSample.getParameters (key.parameters.data());
+        }
+        else
+        {
+            key.name = typeid (EasingType).name();
+            getEasingParameters (curveToSample, key.parameters.data());
+        }
+
+        return key;
+    }
+
+    EasingType curve;
+    EasingTable::Ptr table;
+};
+
+//==============================================================================
+/** Samples an easing functor at numSamples evenly spaced positions over
+    [0, 1], including both ends.
+
+    This is constexpr, so given a functor which can be evaluated at compile
+    time (any of the polynomial, back or bounce easings, or one from
+    EasingFunctions::Constexpr) the table is built by the compiler and costs
+    nothing at startup.
+*/
+template <size_t numSamples, typename EasingType>
+constexpr std::array<double, numSamples> sampleEasingCurve (const EasingType& curve) noexcept
+{
+    static_assert (numSamples >= 2, "A table needs at least two samples");
+
+    std::array<double, numSamples> samples {};
+
+    for (size_t i = 0; i < numSamples; ++i)
+        samples[i] = curve ((double) i / (double) (numSamples - 1));
+
+    return samples;
+}
+
+//==============================================================================
+/** A fixed-size table of easing samples which can be built at compile time,
+    and evaluated as an easing function itself.
+
+    This interpolates between the samples in the same way as EasingTable, but
+    holds them inline rather than sharing them through a cache, so a table
+    declared as a constexpr variable lives in read-only data and needs no
+    allocation or initialisation at runtime. That makes it suitable for
+    embedded targets, and for plugins where many instances are created at once.
+
+    @code
+    static constexpr auto bounceTable = makeStaticEasingTable<128> (EaseOutBounce());
+    static constexpr auto elasticTable = makeStaticEasingTable<256> (Constexpr::EaseOutElastic (1.0, 0.3));
+
+    AnimatedPositionBehaviours::Eased<StaticEasingTable<128>> behaviour;
+    behaviour.easing = bounceTable;
+    @endcode
+
+    @see sampleEasingCurve, TabulatedEasing
+*/
+template <size_t numSamples, EasingTable::Interpolation interpolation = EasingTable::Interpolation::cubic>
+class StaticEasingTable
+{
+public:
+    static_assert (numSamples >= 2, "A table needs at least two samples");
+
+    /** Creates a table from a set of samples, evenly spaced over [0, 1]. */
+    constexpr explicit StaticEasingTable (const std::array<double, numSamples>& samplesToUse) noexcept
+        : samples (samplesToUse)
+    {
+    }
+
+    /** Creates a table of a straight line, so that the type can be used as a
+        default-constructed easing.
+    */
+    constexpr StaticEasingTable() noexcept
+        : samples (sampleEasingCurve<numSamples> (EaseLinear()))
+    {
+    }
+
+    /** Evaluates the tabulated curve at a position in [0, 1]. Positions outside
+        this range are clamped, and the ends return the first and last samples
+        exactly.
+    */
+    constexpr double operator() (double t) const noexcept
+    {
+        // the spline only passes through the last sample to within rounding
+        if (t >= 1.0)
+            return samples[numSamples - 1];
+
+        const double x = (t < 0.0 ? 0.0 : t) * (double) (numSamples - 1);
+        const int index = x < (double) (numSamples - 2) ? (int) x : (int) numSamples - 2;
+        const double f = x - index;
+
+        const double p1 = samples[(size_t) index];
+        const double p2 = samples[(size_t) index + 1];
+
+        if (interpolation == EasingTable::Interpolation::linear)
+            return p1 + f * (p2 - p1);
+
+        // beyond the ends, the samples are extrapolated linearly like EasingTable's
+        const double p0 = index > 0 ? samples[(size_t) index - 1] : 2.0 * p1 - p2;
+        const double p3 = (size_t) index + 2 < numSamples ? samples[(size_t) index + 2] : 2.0 * p2 - p1;
+
+        return p1 + 0.5 * f * (p2 - p0
+                               + f * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3
+                                      + f * (3.0 * (p1 - p2) + p3 - p0)));
+    }
+
+    /** Returns the slope of the tabulated curve at a position in [0, 1]. */
+    constexpr double derivative (double t) const noexcept
+    {
+        const double x = (t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t)) * (double) (numSamples - 1);
+        const int index = x < (double) (numSamples - 2) ? (int) x : (int) numSamples - 2;
+        const double f = x - index;
+
+        const double p1 = samples[(size_t) index];
+        const double p2 = samples[(size_t) index + 1];
+
+        if (interpolation == EasingTable::Interpolation::linear)
+            return (p2 - p1) * (double) (numSamples - 1);
+
+        const double p0 = index > 0 ? samples[(size_t) index - 1] : 2.0 * p1 - p2;
+        const double p3 = (size_t) index + 2 < numSamples ? samples[(size_t) index + 2] : 2.0 * p2 - p1;
+
+        return 0.5 * (double) (numSamples - 1)
+                 * (p2 - p0 + f * (2.0 * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3)
+                                   + f * 3.0 * (3.0 * (p1 - p2) + p3 - p0)));
+    }
+
+    /** Returns the samples in the table. */
+    constexpr const std::array<double, numSamples>& getSamples() const noexcept  { return samples; }
+
+private:
+    std::array<double, numSamples> samples;
+};
+
+/** Returns a StaticEasingTable of a curve, which can be built at compile time
+    if the curve can be evaluated in a constant expression.
+
+    @see sampleEasingCurve
+*/
+template <size_t numSamples,
+          EasingTable::Interpolation interpolation = EasingTable::Interpolation::cubic,
+          typename EasingType>
+constexpr StaticEasingTable<numSamples, interpolation> makeStaticEasingTable (const EasingType& curve) noexcept
+{
+    return StaticEasingTable<numSamples, interpolation> (sampleEasingCurve<numSamples> (curve));
+}
+
+}
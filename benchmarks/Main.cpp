@@ -0,0 +1,532 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+/*  Headless benchmarks for juce_animation.
+
+    Usage: juce_animation_benchmarks [--output <file.json>] [--quick]
+
+    The results are written as JSON (to stdout if no output file is given) so
+    that they can be compared between releases. Every figure is the fastest of
+    several runs.
+*/
+
+#include <juce_animation/juce_animation.h>
+#include <iostream>
+
+using namespace juce;
+
+#ifndef JUCE_ANIMATION_VERSION
+ #define JUCE_ANIMATION_VERSION "unknown"
+#endif
+
+namespace
+{
+
+//==============================================================================
+/** Somewhere for benchmark results to go, so the optimiser can't remove them. */
+volatile double sink = 0.0;
+
+struct Settings
+{
+    int numRuns = 7;
+    int blockSize = 4096;
+    int blockRepeats = 64;
+    int numEasedTicks = 1000000;
+    int numEngineTicks = 200;
+};
+
+/** Runs a function several times and returns the fastest run in seconds. */
+template <typename Fn>
+double timeBestOf (int numRuns, Fn&& fn)
+{
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < numRuns; ++run)
+    {
+        const auto start = Time::getHighResolutionTicks();
+        fn();
+        best = jmin (best, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start));
+    }
+
+    return best;
+}
+
+String getSIMDName()
+{
+   #if JUCE_ANIMATION_USE_AVX2
+    return "AVX2";
+   #elif JUCE_ANIMATION_USE_SSE2
+    return "SSE2";
+   #elif JUCE_ANIMATION_USE_NEON
+    return "NEON";
+   #else
+    return "scalar";
+   #endif
+}
+
+//==============================================================================
+/** Measures the cost of evaluating an easing one value at a time with its
+    operator(), and in blocks with EasingFunctions::processBlock().
+*/
+template <typename EasingType>
+var benchmarkEasing (const String& name, const Settings& settings, EasingType easing = {})
+{
+    HeapBlock<double> input ((size_t) settings.blockSize), output ((size_t) settings.blockSize);
+
+    for (int i = 0; i < settings.blockSize; ++i)
+        input[(size_t) i] = (double) i / (settings.blockSize - 1);
+
+    const double numEvaluations = (double) settings.blockSize * settings.blockRepeats;
+
+    const auto scalar = timeBestOf (settings.numRuns, [&]
+    {
+        for (int r = 0; r < settings.blockRepeats; ++r)
+        {
+            for (int i = 0; i < settings.blockSize; ++i)
+                output[(size_t) i] = easing (input[(size_t) i]);
+
+            sink = sink + output[(size_t) r];
+        }
+    });
+
+    const auto batch = timeBestOf (settings.numRuns, [&]
+    {
+        for (int r = 0; r < settings.blockRepeats; ++r)
+        {
+            EasingFunctions::processBlock (easing, input.get(), output.get(), settings.blockSize);
+            sink = sink + output[(size_t) r];
+        }
+    });
+
+    DynamicObject::Ptr result (new DynamicObject());
+    result->setProperty ("name", name);
+    result->setProperty ("scalarNsPerEval", scalar * 1.0e9 / numEvaluations);
+    result->setProperty ("batchNsPerEval", batch * 1.0e9 / numEvaluations);
+    return var (result.get());
+}
+
+/** The same composition as OutIn<>, built from std::functions as it would be
+    without the combinators, to compare against the combinator and the
+    hand-written curve.
+*/
+std::function<double (double)> composeOutInWithStdFunction (std::function<double (double)> easeIn)
+{
+    std::function<double (double)> easeOut = [easeIn] (double t) { return 1.0 - easeIn (1.0 - t); };
+
+    return [easeIn, easeOut] (double t)
+    {
+        return t < 0.5 ? 0.5 * easeOut (2.0 * t)
+                       : 0.5 + 0.5 * easeIn (2.0 * t - 1.0);
+    };
+}
+
+var benchmarkEasings (const Settings& settings)
+{
+    using namespace EasingFunctions;
+
+    Array<var> results;
+
+    results.add (benchmarkEasing<EaseLinear>       ("EaseLinear",       settings));
+    results.add (benchmarkEasing<EaseInQuad>       ("EaseInQuad",       settings));
+    results.add (benchmarkEasing<EaseOutQuad>      ("EaseOutQuad",      settings));
+    results.add (benchmarkEasing<EaseInOutQuad>    ("EaseInOutQuad",    settings));
+    results.add (benchmarkEasing<EaseOutInQuad>    ("EaseOutInQuad",    settings));
+    results.add (benchmarkEasing<EaseInCubic>      ("EaseInCubic",      settings));
+    results.add (benchmarkEasing<EaseOutCubic>     ("EaseOutCubic",     settings));
+    results.add (benchmarkEasing<EaseInOutCubic>   ("EaseInOutCubic",   settings));
+    results.add (benchmarkEasing<EaseOutInCubic>   ("EaseOutInCubic",   settings));
+    results.add (benchmarkEasing<OutIn<EaseInCubic>> ("OutIn<EaseInCubic>", settings));
+    results.add (benchmarkEasing<std::function<double (double)>> ("std::function OutIn of EaseInCubic",
+                                                                   settings, composeOutInWithStdFunction (EaseInCubic())));
+    results.add (benchmarkEasing<EaseInQuart>      ("EaseInQuart",      settings));
+    results.add (benchmarkEasing<EaseOutQuart>     ("EaseOutQuart",     settings));
+    results.add (benchmarkEasing<EaseInOutQuart>   ("EaseInOutQuart",   settings));
+    results.add (benchmarkEasing<EaseOutInQuart>   ("EaseOutInQuart",   settings));
+    results.add (benchmarkEasing<EaseInQuint>      ("EaseInQuint",      settings));
+    results.add (benchmarkEasing<EaseOutQuint>     ("EaseOutQuint",     settings));
+    results.add (benchmarkEasing<EaseInOutQuint>   ("EaseInOutQuint",   settings));
+    results.add (benchmarkEasing<EaseOutInQuint>   ("EaseOutInQuint",   settings));
+    results.add (benchmarkEasing<EaseInSine>       ("EaseInSine",       settings));
+    results.add (benchmarkEasing<EaseOutSine>      ("EaseOutSine",      settings));
+    results.add (benchmarkEasing<EaseInOutSine>    ("EaseInOutSine",    settings));
+    results.add (benchmarkEasing<EaseOutInSine>    ("EaseOutInSine",    settings));
+    results.add (benchmarkEasing<EaseInExpo>       ("EaseInExpo",       settings));
+    results.add (benchmarkEasing<EaseOutExpo>      ("EaseOutExpo",      settings));
+    results.add (benchmarkEasing<EaseInOutExpo>    ("EaseInOutExpo",    settings));
+    results.add (benchmarkEasing<EaseOutInExpo>    ("EaseOutInExpo",    settings));
+    results.add (benchmarkEasing<EaseInCirc>       ("EaseInCirc",       settings));
+    results.add (benchmarkEasing<EaseOutCirc>      ("EaseOutCirc",      settings));
+    results.add (benchmarkEasing<EaseInOutCirc>    ("EaseInOutCirc",    settings));
+    results.add (benchmarkEasing<EaseOutInCirc>    ("EaseOutInCirc",    settings));
+    results.add (benchmarkEasing<EaseInElastic>    ("EaseInElastic",    settings));
+    results.add (benchmarkEasing<EaseOutElastic>   ("EaseOutElastic",   settings));
+    results.add (benchmarkEasing<EaseInOutElastic> ("EaseInOutElastic", settings));
+    results.add (benchmarkEasing<EaseOutInElastic> ("EaseOutInElastic", settings));
+    results.add (benchmarkEasing<EaseInBack>       ("EaseInBack",       settings));
+    results.add (benchmarkEasing<EaseOutBack>      ("EaseOutBack",      settings));
+    results.add (benchmarkEasing<EaseInOutBack>    ("EaseInOutBack",    settings));
+    results.add (benchmarkEasing<EaseOutInBack>    ("EaseOutInBack",    settings));
+    results.add (benchmarkEasing<EaseInBounce>     ("EaseInBounce",     settings));
+    results.add (benchmarkEasing<EaseOutBounce>    ("EaseOutBounce",    settings));
+    results.add (benchmarkEasing<EaseInOutBounce>  ("EaseInOutBounce",  settings));
+    results.add (benchmarkEasing<EaseOutInBounce>  ("EaseOutInBounce",  settings));
+    results.add (benchmarkEasing<EaseCubicBezier>  ("EaseCubicBezier",  settings));
+
+    return results;
+}
+
+//==============================================================================
+/** Exposes the protected tick methods of a behaviour so they can be driven
+    directly, the same way AnimatedPosition<> drives them from its timer.
+*/
+template <typename Behaviour>
+struct BehaviourProbe  : public Behaviour
+{
+    using Behaviour::releasedWithVelocity;
+    using Behaviour::getNextPosition;
+    using Behaviour::isStopped;
+};
+
+/** Measures one getNextPosition() + isStopped() pair of a looping animation. */
+template <typename Behaviour>
+var benchmarkEasedStep (const String& name, BehaviourProbe<Behaviour>& behaviour, const Settings& settings)
+{
+    behaviour.duration = 1.0;
+    behaviour.loops = -1;
+
+    const auto seconds = timeBestOf (settings.numRuns, [&]
+    {
+        behaviour.releasedWithVelocity (0.0, 0.0);
+        double pos = 0.0;
+
+        for (int i = 0; i < settings.numEasedTicks; ++i)
+        {
+            pos = behaviour.getNextPosition (pos, 1.0 / 60.0);
+            behaviour.isStopped (pos);
+        }
+
+        sink = sink + pos;
+    });
+
+    DynamicObject::Ptr result (new DynamicObject());
+    result->setProperty ("name", name);
+    result->setProperty ("nsPerStep", seconds * 1.0e9 / settings.numEasedTicks);
+    return var (result.get());
+}
+
+var benchmarkEasedSteps (const Settings& settings)
+{
+    using namespace AnimatedPositionBehaviours;
+
+    Array<var> results;
+
+    BehaviourProbe<Eased<>> typeErased;
+    typeErased.easing = EasingFunctions::EaseOutCubic();
+    results.add (benchmarkEasedStep ("Eased<> (EaseOutCubic)", typeErased, settings));
+
+    BehaviourProbe<Eased<EasingFunctions::EaseOutCubic>> inlined;
+    results.add (benchmarkEasedStep ("Eased<EaseOutCubic>", inlined, settings));
+
+    return results;
+}
+
+//==============================================================================
+/** Measures the message thread's share of AnimationEngine::tick() with a mix
+    of durations and curves. In background mode the worker is given time to
+    finish each frame between ticks, as it would be between two vsyncs.
+*/
+var benchmarkEngine (int numAnimations, AnimationEngine::Evaluation evaluation, const Settings& settings)
+{
+    AnimationEngine engine;
+    engine.setEvaluation (evaluation);
+
+    const int curves[] = { 0,
+                           engine.addEasing (EasingFunctions::EaseOutCubic()),
+                           engine.addEasing (EasingFunctions::EaseInOutQuad()),
+                           engine.addEasing (EasingFunctions::EaseOutBounce()) };
+
+    for (int i = 0; i < numAnimations; ++i)
+    {
+        AnimationEngine::Options options;
+        options.duration = 0.25 + 0.01 * (i % 100);
+        options.loops = -1;
+        options.pingpong = (i & 1) != 0;
+        options.endValue = 100.0;
+        options.easing = curves[i % 4];
+        options.onUpdate = [] (double v) { sink = sink + v; };
+
+        engine.addAnimation (options);
+    }
+
+    const bool isBackground = evaluation == AnimationEngine::Evaluation::backgroundThread;
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < settings.numRuns; ++run)
+    {
+        int64 ticks = 0;
+
+        for (int i = 0; i < settings.numEngineTicks; ++i)
+        {
+            const auto start = Time::getHighResolutionTicks();
+            engine.tick (1.0 / 60.0);
+            ticks += Time::getHighResolutionTicks() - start;
+
+            if (isBackground)
+                Thread::sleep (1);
+        }
+
+        best = jmin (best, Time::highResolutionTicksToSeconds (ticks));
+    }
+
+    const double perTick = best / settings.numEngineTicks;
+
+    DynamicObject::Ptr result (new DynamicObject());
+    result->setProperty ("evaluation", isBackground ? "backgroundThread" : "messageThread");
+    result->setProperty ("animations", numAnimations);
+    result->setProperty ("usPerTick", perTick * 1.0e6);
+    result->setProperty ("nsPerAnimation", perTick * 1.0e9 / numAnimations);
+    result->setProperty ("budgetPercentAt60Hz", perTick * 60.0 * 100.0);
+    return var (result.get());
+}
+
+var benchmarkEngineTicks (const Settings& settings)
+{
+    Array<var> results;
+
+    for (auto evaluation : { AnimationEngine::Evaluation::messageThread,
+                             AnimationEngine::Evaluation::backgroundThread })
+        for (auto numAnimations : { 100, 1000, 10000 })
+            results.add (benchmarkEngine (numAnimations, evaluation, settings));
+
+    return results;
+}
+
+//==============================================================================
+/** Measures how the evaluation part of AnimationEngine::tick() scales with
+    setNumEvaluationThreads(), for one curve shared by every animation.
+*/
+var benchmarkParallelEngine (int numAnimations, int numThreads, const Settings& settings)
+{
+    AnimationEngine engine;
+    engine.setNumEvaluationThreads (numThreads, 1);
+    engine.setStatsEnabled (true);
+    engine.reserve (numAnimations);
+
+    const auto curve = engine.addEasing (EasingFunctions::EaseInOutCubic());
+
+    for (int i = 0; i < numAnimations; ++i)
+    {
+        AnimationEngine::Options options;
+        options.duration = 0.25 + 0.01 * (i % 100);
+        options.loops = -1;
+        options.endValue = 100.0;
+        options.easing = curve;
+
+        engine.addAnimation (options);
+    }
+
+    double best = std::numeric_limits<double>::max();
+
+    for (int run = 0; run < settings.numRuns; ++run)
+    {
+        double ms = 0.0;
+
+        for (int i = 0; i < settings.numEngineTicks; ++i)
+        {
+            engine.tick (1.0 / 60.0);
+            ms += engine.getStats().evaluationMs;
+        }
+
+        best = jmin (best, ms / settings.numEngineTicks);
+    }
+
+    DynamicObject::Ptr result (new DynamicObject());
+    result->setProperty ("animations", numAnimations);
+    result->setProperty ("threads", engine.getNumEvaluationThreads());
+    result->setProperty ("evaluationUsPerTick", best * 1.0e3);
+    return var (result.get());
+}
+
+var benchmarkParallelEngineScaling (const Settings& settings)
+{
+    Array<var> results;
+
+    for (auto numAnimations : { 50000, 200000 })
+        for (auto numThreads : { 1, 2, 4, 8, 16 })
+            results.add (benchmarkParallelEngine (numAnimations, numThreads, settings));
+
+    return results;
+}
+
+//==============================================================================
+/** Builds a library of eased and keyframed presets with varied curves, named
+    so that they aren't added in the order they're stored.
+*/
+AnimationPresetLibrary::Writer& addBenchmarkPresets (AnimationPresetLibrary::Writer& writer, int numPresets)
+{
+    using namespace EasingFunctions;
+
+    const AnyEasing easings[] = { EaseOutCubic(),
+                                  EaseInOutQuad(),
+                                  EaseOutBack { 2.5 },
+                                  EaseOutElastic (1.2, 0.8),
+                                  EaseCubicBezier (0.3, 0.0, 0.2, 1.0),
+                                  EaseOutBounce() };
+
+    for (int i = 0; i < numPresets; ++i)
+    {
+        const auto name = "preset" + String ((i * 7919) % numPresets).paddedLeft ('0', 5);
+        const auto& easing = easings[i % numElementsInArray (easings)];
+
+        if (i % 10 == 0)
+        {
+            KeyframeTrack<double> track;
+
+            for (int k = 0; k < 8; ++k)
+                track.addKeyframe (0.25 * k, 10.0 * (k % 3), easing);
+
+            writer.addKeyframes (name, track);
+        }
+        else
+        {
+            writer.addEased (name, 0.25 + 0.01 * (i % 100), i % 3, (i & 1) != 0, easing);
+        }
+    }
+
+    return writer;
+}
+
+/** Measures building a preset library, opening it, looking presets up and,
+    where ValueTrees are available, converting it to a ValueTree and back.
+*/
+var benchmarkPresetLibrary (int numPresets, const Settings& settings)
+{
+    MemoryBlock data;
+
+    const auto build = timeBestOf (settings.numRuns, [&]
+    {
+        AnimationPresetLibrary::Writer writer;
+        data = addBenchmarkPresets (writer, numPresets).createData();
+    });
+
+    const auto open = timeBestOf (settings.numRuns, [&]
+    {
+        AnimationPresetLibrary library (data.getData(), data.getSize());
+        sink = sink + library.getNumPresets();
+    });
+
+    const auto lastName = "preset" + String (numPresets - 1).paddedLeft ('0', 5);
+
+    const auto firstLookup = timeBestOf (settings.numRuns, [&]
+    {
+        AnimationPresetLibrary library (data.getData(), data.getSize());
+        sink = sink + library.getEasing (library.indexOf (lastName)) (0.5);
+    });
+
+    AnimationPresetLibrary library (data.getData(), data.getSize());
+    Array<const char*> names;
+
+    for (int i = 0; i < library.getNumPresets(); ++i)
+        names.add (library.getName ((i * 7919) % library.getNumPresets()));
+
+    const auto lookups = timeBestOf (settings.numRuns, [&]
+    {
+        for (auto* name : names)
+            sink = sink + library.getEasing (library.indexOf (name)) (0.5);
+    });
+
+    DynamicObject::Ptr result (new DynamicObject());
+    result->setProperty ("presets", library.getNumPresets());
+    result->setProperty ("bytes", (int64) data.getSize());
+    result->setProperty ("buildMs", build * 1.0e3);
+    result->setProperty ("openUs", open * 1.0e6);
+    result->setProperty ("firstLookupUs", firstLookup * 1.0e6);
+    result->setProperty ("nsPerLookup", lookups * 1.0e9 / jmax (1, names.size()));
+
+   #if JUCE_MODULE_AVAILABLE_juce_data_structures
+    const auto roundTrip = timeBestOf (settings.numRuns, [&]
+    {
+        AnimationPresetLibrary::Writer writer;
+        const auto converted = writer.addFromValueTree (library.toValueTree());
+        sink = sink + (converted.wasOk() ? writer.getNumPresets() : -1);
+    });
+
+    result->setProperty ("valueTreeRoundTripMs", roundTrip * 1.0e3);
+   #endif
+
+    return var (result.get());
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    ArgumentList args (argc, argv);
+
+    Settings settings;
+
+    if (args.containsOption ("--quick"))
+    {
+        settings.numRuns = 2;
+        settings.blockRepeats = 4;
+        settings.numEasedTicks = 20000;
+        settings.numEngineTicks = 10;
+    }
+
+    // the engine's timer needs a message manager, even though it isn't used here
+    MessageManager::getInstance();
+
+    DynamicObject::Ptr root (new DynamicObject());
+    root->setProperty ("module", "juce_animation");
+    root->setProperty ("version", JUCE_ANIMATION_VERSION);
+    root->setProperty ("juceVersion", SystemStats::getJUCEVersion());
+    root->setProperty ("timestamp", Time::getCurrentTime().toISO8601 (true));
+    root->setProperty ("simd", getSIMDName());
+    root->setProperty ("numCpus", SystemStats::getNumCpus());
+    root->setProperty ("easing", benchmarkEasings (settings));
+    root->setProperty ("eased", benchmarkEasedSteps (settings));
+    root->setProperty ("engine", benchmarkEngineTicks (settings));
+    root->setProperty ("parallelEngine", benchmarkParallelEngineScaling (settings));
+    root->setProperty ("presetLibrary", benchmarkPresetLibrary (5000, settings));
+
+    const auto json = JSON::toString (var (root.get()));
+    const auto outputPath = args.getValueForOption ("--output|-o");
+
+    if (outputPath.isNotEmpty())
+    {
+        const auto file = File::getCurrentWorkingDirectory().getChildFile (outputPath);
+
+        if (! file.replaceWithText (json))
+        {
+            std::cerr << "Couldn't write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    MessageManager::deleteInstance();
+    return 0;
+}
@@ -34,5 +34,17 @@
 
 namespace juce
 {
-
+    #include "animation/juce_TabulatedEasing.cpp"
+    #include "animation/juce_AnimationEngine.cpp"
+    #include "animation/juce_AnimationUpdateQueue.cpp"
+    #include "animation/juce_AnimationTimeline.cpp"
+    #include "animation/juce_AnimationPresetLibrary.cpp"
+    #include "animation/juce_ManualAnimationClock.cpp"
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    #include "animation/juce_ComponentPropertyAnimator.cpp"
+    #include "animation/juce_OfflineAnimationRenderer.cpp"
+   #endif
 }
+
+#include "animation/juce_AllocationCounter.cpp"
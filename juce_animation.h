@@ -31,7 +31,7 @@ BEGIN_JUCE_MODULE_DECLARATION
  website:          http://www.github.com/lassandroan/juce_animation
  license:          GPLv3
 
- dependencies:     juce_core, juce_data_structures, juce_events, juce_gui_basics
+ dependencies:     juce_core, juce_events
 
 END_JUCE_MODULE_DECLARATION
 ******************************************************************************/
@@ -39,15 +39,91 @@ END_JUCE_MODULE_DECLARATION
 #pragma once
 #define JUCE_ANIMATION_H_INCLUDED
 
+#include <cstddef>
+#include <ratio>
+#include <variant>
+
 #include <juce_core/juce_core.h>
-#include <juce_data_structures/juce_data_structures.h>
 #include <juce_events/juce_events.h>
-#include <juce_gui_basics/juce_gui_basics.h>
-
-//==============================================================================
-
-namespace juce
-{
-    #include "animation/juce_EasingFunctions.h"
-    #include "animation/juce_AnimatedPositionBehaviours.h"
+
+/*  juce_data_structures and juce_gui_basics are optional, so that the easing
+    functions and the engine can be built headless. The classes that need them
+    are only available when those modules are part of the project.
+*/
+#if JUCE_MODULE_AVAILABLE_juce_data_structures
+ #include <juce_data_structures/juce_data_structures.h>
+#endif
+
+#if JUCE_MODULE_AVAILABLE_juce_gui_basics
+ #include <juce_gui_basics/juce_gui_basics.h>
+#else
+ namespace juce
+ {
+     // the behaviours only need this for their friend declarations
+     template <typename Behaviour> class AnimatedPosition;
+ }
+#endif
+
+//==============================================================================
+/** Config: JUCE_ANIMATION_DISABLE_SIMD
+    Disables the SSE2/AVX2/NEON kernels used by EasingFunctions::processBlock()
+    and falls back to the portable scalar implementation.
+*/
+#ifndef JUCE_ANIMATION_DISABLE_SIMD
+ #define JUCE_ANIMATION_DISABLE_SIMD 0
+#endif
+
+#if ! JUCE_ANIMATION_DISABLE_SIMD
+ #if defined (__AVX2__)
+  #define JUCE_ANIMATION_USE_AVX2 1
+  #include <immintrin.h>
+ #elif defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define JUCE_ANIMATION_USE_SSE2 1
+  #include <emmintrin.h>
+ #elif defined (__ARM_NEON) && defined (__aarch64__)
+  #define JUCE_ANIMATION_USE_NEON 1
+  #include <arm_neon.h>
+ #endif
+#endif
+
+//==============================================================================
+/** Config: JUCE_ANIMATION_COUNT_ALLOCATIONS
+    Replaces the global operator new with one that counts the allocations made
+    on each thread, which are reported by AllocationCounter and
+    AnimationEngine::getNumAllocationsInLastTick(). Only enable this in test or
+    debug builds.
+*/
+#ifndef JUCE_ANIMATION_COUNT_ALLOCATIONS
+ #define JUCE_ANIMATION_COUNT_ALLOCATIONS 0
+#endif
+
+//==============================================================================
+
+namespace juce
+{
+    #include "animation/juce_EasingFunctions.h"
+    #include "animation/juce_ConstexprEasingFunctions.h"
+    #include "animation/juce_EasingFunctionsSIMD.h"
+    #include "animation/juce_EasingCombinators.h"
+    #include "animation/juce_AnyEasing.h"
+    #include "animation/juce_TabulatedEasing.h"
+    #include "animation/juce_KeyframeTrack.h"
+    #include "animation/juce_AnimatedValue.h"
+    #include "animation/juce_AnimationTimeline.h"
+    #include "animation/juce_AllocationCounter.h"
+    #include "animation/juce_InplaceFunction.h"
+    #include "animation/juce_AnimationEngine.h"
+    #include "animation/juce_AnimationUpdateQueue.h"
+    #include "animation/juce_AnimatedPositionBehaviours.h"
+    #include "animation/juce_AnimationPresetLibrary.h"
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    #include "animation/juce_ComponentPropertyAnimator.h"
+   #endif
+
+    #include "animation/juce_ManualAnimationClock.h"
+
+   #if JUCE_MODULE_AVAILABLE_juce_gui_basics
+    #include "animation/juce_OfflineAnimationRenderer.h"
+   #endif
 }
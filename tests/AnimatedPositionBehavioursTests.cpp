@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+/** Exposes the protected tick methods of a behaviour, so that it can be driven
+    in the same way that AnimatedPosition<> drives it from its timer.
+*/
+template <typename Behaviour>
+struct BehaviourProbe  : public Behaviour
+{
+    using Behaviour::releasedWithVelocity;
+    using Behaviour::getNextPosition;
+    using Behaviour::isStopped;
+
+    /** Ticks until the behaviour stops, as AnimatedPosition<> would, and
+        returns the last position.
+    */
+    double runToEnd (double position, double deltaSeconds = 1.0 / 60.0, int maxTicks = 100000)
+    {
+        for (int i = 0; i < maxTicks; ++i)
+        {
+            position = getNextPosition (position, deltaSeconds);
+
+            if (isStopped (position))
+                break;
+        }
+
+        return position;
+    }
+};
+
+//==============================================================================
+class AnimatedPositionBehavioursTests  : public UnitTest
+{
+public:
+    AnimatedPositionBehavioursTests()  : UnitTest ("AnimatedPositionBehaviours", "Animation") {}
+
+    void runTest() override
+    {
+        testPhases();
+        testAbsoluteTime();
+        testRetarget();
+        testSpringSettles();
+    }
+
+private:
+    using Eased = AnimatedPositionBehaviours::Eased<EasingFunctions::EaseInOutCubic>;
+
+    //==============================================================================
+    void expectPhase (const AnimatedPositionBehaviours::EasedPhase& phase, int loop, bool reversed,
+                      bool finished, double proportion)
+    {
+        expectEquals (phase.loop, loop);
+        expect (phase.reversed == reversed);
+        expect (phase.finished == finished);
+        expectWithinAbsoluteError (phase.proportion, proportion, 1.0e-12);
+    }
+
+    void testPhases()
+    {
+        using AnimatedPositionBehaviours::EasedPhase;
+
+        beginTest ("A single pass runs forwards and then holds its end");
+
+        expectPhase (EasedPhase::at (-1.0, 2.0, 0, false), 0, false, false, 0.0);
+        expectPhase (EasedPhase::at (0.5, 2.0, 0, false), 0, false, false, 0.25);
+        expectPhase (EasedPhase::at (3.0, 2.0, 0, false), 0, false, true, 1.0);
+        expectPhase (EasedPhase::at (3.0, 2.0, 0, true), 0, false, true, 1.0);
+        expectPhase (EasedPhase::at (0.5, 0.0, 0, false), 0, false, true, 1.0);
+
+        beginTest ("Looping restarts each pass from the beginning");
+
+        expectPhase (EasedPhase::at (1.25, 1.0, 2, false), 1, false, false, 0.25);
+        expectPhase (EasedPhase::at (2.75, 1.0, 2, false), 2, false, false, 0.75);
+        expectPhase (EasedPhase::at (3.5, 1.0, 2, false), 2, false, true, 1.0);
+
+        beginTest ("Ping-pong reverses every other pass and ends where the last pass does");
+
+        expectPhase (EasedPhase::at (0.25, 1.0, 2, true), 0, false, false, 0.25);
+        expectPhase (EasedPhase::at (1.25, 1.0, 2, true), 1, true, false, 0.75);
+        expectPhase (EasedPhase::at (2.25, 1.0, 2, true), 2, false, false, 0.25);
+        expectPhase (EasedPhase::at (3.5, 1.0, 2, true), 2, false, true, 1.0);
+        expectPhase (EasedPhase::at (2.5, 1.0, 1, true), 1, true, true, 0.0);
+
+        beginTest ("Endless loops can be evaluated far into the future");
+
+        expectPhase (EasedPhase::at (1.0e6 + 0.25, 1.0, -1, true), 1000000, false, false, 0.25);
+        expectPhase (EasedPhase::at (1.0e6 + 1.25, 1.0, -1, true), 1000001, true, false, 0.75);
+        expectEquals (EasedPhase::at (1.0e12, 1.0, -1, false).loop, std::numeric_limits<int>::max());
+    }
+
+    void testAbsoluteTime()
+    {
+        beginTest ("Eased positions only depend on the time since release");
+
+        BehaviourProbe<Eased> eased;
+        eased.duration = 0.5;
+        eased.loops = 3;
+        eased.pingpong = true;
+        eased.releasedWithVelocity (0.0, 0.0);
+
+        expectEquals (eased.getTotalDuration(), 2.0);
+
+        const EasingFunctions::EaseInOutCubic curve;
+        double position = 0.0;
+
+        for (int i = 1; i <= 30; ++i)
+        {
+            position = eased.getNextPosition (position, 1.0 / 16.0);
+
+            const auto phase = eased.getPhaseAt (i / 16.0);
+            expectWithinAbsoluteError (position, curve (phase.proportion), 1.0e-12);
+            expectWithinAbsoluteError (eased.evaluateAt (i / 16.0), position, 1.0e-12);
+        }
+
+        beginTest ("seek() moves straight to any point");
+
+        eased.seek (1.125);
+        expectWithinAbsoluteError (eased.getNextPosition (0.0, 0.0), curve (0.25), 1.0e-12);
+        expectEquals (eased.getElapsedTime(), 1.125);
+
+        eased.loops = -1;
+        expect (eased.getTotalDuration() == std::numeric_limits<double>::infinity());
+
+        beginTest ("Long runs of small ticks don't drift");
+
+        eased.seek (0.0);
+
+        for (int i = 0; i < 60 * 60 * 60; ++i)
+            eased.getNextPosition (0.0, 1.0 / 60.0);
+
+        expectWithinAbsoluteError (eased.getElapsedTime(), 3600.0, 1.0e-9);
+    }
+
+    //==============================================================================
+    void testRetarget()
+    {
+        beginTest ("Retargeting keeps the position and velocity continuous");
+
+        {
+            BehaviourProbe<Eased> eased;
+            eased.duration = 1.0;
+            eased.releasedWithVelocity (0.0, 0.0);
+
+            for (int i = 0; i < 20; ++i)
+                eased.getNextPosition (0.0, 1.0 / 60.0);
+
+            const double time = eased.getElapsedTime();
+            const double position = eased.evaluateAt (time);
+            const double velocity = eased.getVelocityAt (time);
+
+            eased.retarget (5.0);
+
+            expectEquals (eased.getTarget(), 5.0);
+            expectWithinAbsoluteError (eased.evaluateAt (0.0), position, 1.0e-12);
+            expectWithinAbsoluteError (eased.getVelocityAt (0.0), velocity, 1.0e-9);
+
+            // and the velocity given matches the curve's slope
+            constexpr double h = 1.0e-6;
+            const double numeric = (eased.evaluateAt (0.3 + h) - eased.evaluateAt (0.3 - h)) / (2.0 * h);
+            expectWithinAbsoluteError (eased.getVelocityAt (0.3), numeric, 1.0e-5);
+
+            expectWithinAbsoluteError (eased.runToEnd (position), 5.0, 1.0e-12);
+        }
+
+        beginTest ("Retargeting a finished animation leaves from where it stopped");
+
+        {
+            BehaviourProbe<Eased> eased;
+            eased.duration = 0.5;
+            eased.releasedWithVelocity (0.0, 0.0);
+
+            expectWithinAbsoluteError (eased.runToEnd (0.0), 1.0, 1.0e-12);
+
+            eased.retarget (3.0);
+
+            expectWithinAbsoluteError (eased.evaluateAt (0.0), 1.0, 1.0e-12);
+            expectWithinAbsoluteError (eased.getVelocityAt (0.0), 0.0, 1.0e-12);
+
+            const double first = eased.getNextPosition (1.0, 1.0 / 60.0);
+            expectGreaterOrEqual (first, 1.0);
+            expectLessThan (first, 1.1);
+
+            expectWithinAbsoluteError (eased.runToEnd (first), 3.0, 1.0e-12);
+        }
+
+        {
+            // a ping-pong animation with one loop comes back to where it started
+            BehaviourProbe<Eased> eased;
+            eased.duration = 0.25;
+            eased.loops = 1;
+            eased.pingpong = true;
+            eased.releasedWithVelocity (0.0, 0.0);
+
+            expectWithinAbsoluteError (eased.runToEnd (0.0), 0.0, 1.0e-12);
+
+            eased.retarget (2.0);
+            expectWithinAbsoluteError (eased.evaluateAt (0.0), 0.0, 1.0e-12);
+        }
+
+        beginTest ("Retargeting with an explicit velocity keeps that velocity");
+
+        {
+            BehaviourProbe<Eased> eased;
+            eased.duration = 1.0;
+            eased.retarget (2.0, 10.0, -4.0);
+
+            expectWithinAbsoluteError (eased.evaluateAt (0.0), 2.0, 1.0e-12);
+            expectWithinAbsoluteError (eased.getVelocityAt (0.0), -4.0, 1.0e-9);
+
+            expectWithinAbsoluteError (eased.runToEnd (2.0), 10.0, 1.0e-12);
+            expectWithinAbsoluteError (eased.getVelocityAt (1.0), 0.0, 1.0e-9);
+        }
+    }
+
+    void testSpringSettles()
+    {
+        beginTest ("Springs land exactly on their target when they settle");
+
+        for (auto damping : { 4.0, 20.0, 60.0 })
+        {
+            BehaviourProbe<AnimatedPositionBehaviours::Spring> spring;
+            spring.damping = damping;
+            spring.target = 3.0;
+            spring.releasedWithVelocity (-2.0, 5.0);
+
+            expect (spring.runToEnd (-2.0) == 3.0);
+            expect (spring.evaluateAt (spring.getSettleTime()) == 3.0);
+            expect (spring.getVelocityAt (spring.getSettleTime()) == 0.0);
+        }
+    }
+};
+
+static AnimatedPositionBehavioursTests animatedPositionBehavioursTests;
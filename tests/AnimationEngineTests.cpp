@@ -0,0 +1,436 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+class AnimationEngineTests  : public UnitTest
+{
+public:
+    AnimationEngineTests()  : UnitTest ("AnimationEngine", "Animation") {}
+
+    void runTest() override
+    {
+        testPasses();
+        testAllocations();
+        testBackgroundFrames();
+        testBackgroundFinished();
+        testSwitchingEvaluation();
+        testBackgroundReserve();
+        testBackgroundRemoveAll();
+    }
+
+private:
+    //==============================================================================
+    static AnimationEngine::Options makeOptions (double duration, int easing = 0)
+    {
+        AnimationEngine::Options options;
+        options.duration = duration;
+        options.endValue = 100.0;
+        options.easing = easing;
+        return options;
+    }
+
+    /** Waits for the worker to publish a frame, so that background ticks see
+        the results of the one before.
+    */
+    static void tickAndWait (AnimationEngine& engine, double deltaSeconds)
+    {
+        engine.tick (deltaSeconds);
+        Thread::sleep (2);
+    }
+
+    //==============================================================================
+    void testPasses()
+    {
+        beginTest ("A single pass runs from the start to the end value and finishes");
+
+        {
+            AnimationEngine engine;
+            engine.setTimerEnabled (false);
+
+            double lastUpdate = -1.0;
+            int numFinished = 0;
+
+            auto options = makeOptions (1.0);
+            options.onUpdate = [&lastUpdate] (double v) { lastUpdate = v; };
+            options.onFinished = [&numFinished] { ++numFinished; };
+
+            const auto id = engine.addAnimation (options);
+
+            engine.tick (0.25);
+            expectWithinAbsoluteError (engine.getValue (id), 25.0, 1.0e-9);
+            expectWithinAbsoluteError (lastUpdate, 25.0, 1.0e-9);
+
+            engine.tick (0.8);
+            expect (! engine.isAnimating (id));
+            expectEquals (lastUpdate, 100.0);
+            expectEquals (numFinished, 1);
+
+            engine.tick (0.25);
+            expectEquals (numFinished, 1);
+        }
+
+        beginTest ("Loops restart each pass, and ping-pong reverses every other one");
+
+        {
+            AnimationEngine engine;
+            engine.setTimerEnabled (false);
+
+            auto looping = makeOptions (1.0);
+            looping.loops = 2;
+
+            auto pingpong = looping;
+            pingpong.pingpong = true;
+
+            const auto loopingId = engine.addAnimation (looping);
+            const auto pingpongId = engine.addAnimation (pingpong);
+
+            engine.tick (1.25);
+            expectWithinAbsoluteError (engine.getValue (loopingId), 25.0, 1.0e-9);
+            expectWithinAbsoluteError (engine.getValue (pingpongId), 75.0, 1.0e-9);
+
+            engine.tick (1.0);
+            expectWithinAbsoluteError (engine.getValue (loopingId), 25.0, 1.0e-9);
+            expectWithinAbsoluteError (engine.getValue (pingpongId), 25.0, 1.0e-9);
+        }
+
+        beginTest ("Animations end on the value their last pass ends on");
+
+        for (auto loops : { 0, 1, 2, 3 })
+        {
+            for (auto pingpong : { false, true })
+            {
+                AnimationEngine engine;
+                engine.setTimerEnabled (false);
+
+                double lastUpdate = -1.0;
+
+                auto options = makeOptions (0.5);
+                options.startValue = 10.0;
+                options.loops = loops;
+                options.pingpong = pingpong;
+                options.onUpdate = [&lastUpdate] (double v) { lastUpdate = v; };
+
+                const auto id = engine.addAnimation (options);
+
+                // several passes, and the end, in a single tick
+                engine.tick (10.0);
+
+                expect (! engine.isAnimating (id));
+                expectEquals (lastUpdate, pingpong && (loops & 1) != 0 ? 10.0 : 100.0);
+            }
+        }
+
+        beginTest ("Passes follow the same timing as the Eased behaviour");
+
+        {
+            AnimationEngine engine;
+            engine.setTimerEnabled (false);
+
+            const EasingFunctions::EaseInOutCubic curve;
+            const auto cubic = engine.addEasing (curve);
+
+            auto options = makeOptions (0.3, cubic);
+            options.loops = -1;
+            options.pingpong = true;
+
+            const auto id = engine.addAnimation (options);
+            auto random = getRandom();
+            double time = 0.0;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const double step = 0.2 * random.nextDouble();
+                engine.tick (step);
+                time += step;
+
+                const auto phase = AnimatedPositionBehaviours::EasedPhase::at (time, 0.3, -1, true);
+                expectWithinAbsoluteError (engine.getValue (id), 100.0 * curve (phase.proportion), 1.0e-6);
+            }
+        }
+    }
+
+    //==============================================================================
+    void testAllocations()
+    {
+        beginTest ("Starting, stopping and ticking don't allocate once reserved");
+
+        if (! AllocationCounter::isEnabled())
+        {
+            logMessage ("Skipped: JUCE_ANIMATION_COUNT_ALLOCATIONS is off");
+            return;
+        }
+
+        AnimationEngine engine;
+        engine.setTimerEnabled (false);
+
+        const auto bounce = engine.addEasing (EasingFunctions::EaseOutBounce());
+        engine.reserve (512);
+
+        double total = 0.0;
+        int numFinished = 0;
+        int64 startStopAllocations = 0, worstTick = 0;
+        auto random = getRandom();
+
+        for (int frame = 0; frame < 600; ++frame)
+        {
+            {
+                const AllocationCounter::Scope allocations;
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    auto options = makeOptions (0.05 + 0.3 * random.nextDouble(), (i & 1) != 0 ? bounce : 0);
+                    options.onUpdate = [&total] (double v) { total += v; };
+                    options.onFinished = [&numFinished] { ++numFinished; };
+
+                    const auto id = engine.addAnimation (options);
+
+                    if (i == 2)
+                        engine.retarget (id, 50.0);
+                    else if (i == 3)
+                        engine.removeAnimation (id);
+                }
+
+                startStopAllocations += allocations.getNumAllocations();
+            }
+
+            engine.tick (1.0 / 60.0);
+
+            // the first ticks grow the arrays that reserve() doesn't cover,
+            // such as the callbacks' scratch space
+            if (frame > 10)
+                worstTick = jmax (worstTick, engine.getNumAllocationsInLastTick());
+        }
+
+        expectEquals (startStopAllocations, (int64) 0);
+        expectEquals (worstTick, (int64) 0);
+        expectGreaterThan (numFinished, 0);
+    }
+
+    void testBackgroundFrames()
+    {
+        beginTest ("Background frames are handed over whole and in order");
+
+        AnimationEngine engine;
+        engine.setTimerEnabled (false);
+        engine.setEvaluation (AnimationEngine::Evaluation::backgroundThread);
+
+        // identical animations, so every value in an intact frame is the same
+        for (int i = 0; i < 3000; ++i)
+            engine.addAnimation (makeOptions (100.0));
+
+        double previous = 0.0;
+        int numFrames = 0, numTorn = 0;
+
+        for (int tick = 0; tick < 400; ++tick)
+        {
+            // mostly no waiting, so the message thread regularly catches the
+            // worker in the middle of a frame
+            engine.tick (1.0 / 60.0);
+
+            if (tick % 4 == 0)
+                Thread::sleep (1);
+
+            const int num = engine.getNumAnimations();
+
+            if (num == 0)
+                continue;
+
+            const double* values = engine.getValues();
+            ++numFrames;
+
+            for (int i = 1; i < num; ++i)
+            {
+                if (values[i] != values[0])
+                {
+                    ++numTorn;
+                    break;
+                }
+            }
+
+            expect (values[0] >= previous, "a frame must never be older than the last one");
+            previous = values[0];
+        }
+
+        expectEquals (numTorn, 0);
+        expectGreaterThan (numFrames, 0);
+
+        tickAndWait (engine, 1.0 / 60.0);
+        tickAndWait (engine, 1.0 / 60.0);
+
+        // the values are at most one time step behind
+        expectEquals (engine.getNumAnimations(), 3000);
+        expectWithinAbsoluteError (engine.getValues()[0], 401.5 / 60.0, 0.5 / 60.0 + 1.0e-9);
+    }
+
+    void testBackgroundFinished()
+    {
+        beginTest ("Every finished animation is delivered once, even when frames are skipped");
+
+        AnimationEngine engine;
+        engine.setTimerEnabled (false);
+        engine.setEvaluation (AnimationEngine::Evaluation::backgroundThread);
+
+        constexpr int numAnimations = 1000;
+        Array<int> timesFinished;
+        Array<double> finalValues;
+        timesFinished.insertMultiple (0, 0, numAnimations);
+        finalValues.insertMultiple (0, 0.0, numAnimations);
+
+        Array<AnimationEngine::AnimationId> ids;
+        auto random = getRandom();
+
+        for (int i = 0; i < numAnimations; ++i)
+        {
+            auto options = makeOptions (0.01 + 0.5 * random.nextDouble());
+            options.onUpdate = [&finalValues, i] (double v) { finalValues.set (i, v); };
+            options.onFinished = [&timesFinished, i] { timesFinished.set (i, timesFinished[i] + 1); };
+            ids.add (engine.addAnimation (options));
+        }
+
+        const auto anyAnimating = [&engine, &ids]
+        {
+            return std::any_of (ids.begin(), ids.end(), [&engine] (auto id) { return engine.isAnimating (id); });
+        };
+
+        for (int tick = 0; tick < 100; ++tick)
+            engine.tick (1.0 / 60.0);
+
+        for (int tick = 0; tick < 100 && anyAnimating(); ++tick)
+            tickAndWait (engine, 1.0 / 60.0);
+
+        expect (! anyAnimating());
+        tickAndWait (engine, 1.0 / 60.0);
+
+        for (int i = 0; i < numAnimations; ++i)
+        {
+            expectEquals (timesFinished[i], 1);
+            expectEquals (finalValues[i], 100.0);
+        }
+    }
+
+    void testSwitchingEvaluation()
+    {
+        beginTest ("Running animations carry on across a change of evaluation");
+
+        AnimationEngine engine;
+        engine.setTimerEnabled (false);
+
+        auto options = makeOptions (1.0);
+        options.loops = -1;
+        const auto id = engine.addAnimation (options);
+
+        engine.tick (0.25);
+        expectWithinAbsoluteError (engine.getValue (id), 25.0, 1.0e-9);
+
+        engine.setEvaluation (AnimationEngine::Evaluation::backgroundThread);
+        expect (engine.isAnimating (id));
+
+        tickAndWait (engine, 0.25);
+        tickAndWait (engine, 0.0);
+        expectWithinAbsoluteError (engine.getValue (id), 50.0, 1.0e-9);
+
+        engine.setEvaluation (AnimationEngine::Evaluation::messageThread);
+        expect (engine.isAnimating (id));
+
+        engine.tick (0.25);
+        expectWithinAbsoluteError (engine.getValue (id), 75.0, 1.0e-9);
+    }
+
+    void testBackgroundReserve()
+    {
+        beginTest ("Reserving in background mode while the worker is evaluating");
+
+        AnimationEngine engine;
+        engine.setTimerEnabled (false);
+        engine.setEvaluation (AnimationEngine::Evaluation::backgroundThread);
+
+        Array<AnimationEngine::AnimationId> ids;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto options = makeOptions (10.0);
+            options.loops = -1;
+            ids.add (engine.addAnimation (options));
+        }
+
+        // each reserve() grows the buffers the worker evaluates into, while
+        // it's in the middle of a frame
+        for (int i = 0; i < 50; ++i)
+        {
+            engine.tick (1.0 / 60.0);
+            engine.reserve (2000 + 500 * i);
+        }
+
+        tickAndWait (engine, 1.0 / 60.0);
+        tickAndWait (engine, 1.0 / 60.0);
+
+        for (auto id : ids)
+            expect (engine.isAnimating (id));
+
+        expectEquals (engine.getNumAnimations(), ids.size());
+        expectGreaterThan (engine.getValue (ids.getFirst()), 0.0);
+    }
+
+    void testBackgroundRemoveAll()
+    {
+        beginTest ("Removing all animations in background mode releases every id");
+
+        AnimationEngine engine;
+        engine.setTimerEnabled (false);
+        engine.setEvaluation (AnimationEngine::Evaluation::backgroundThread);
+
+        Array<AnimationEngine::AnimationId> ids;
+
+        for (int i = 0; i < 100; ++i)
+            ids.add (engine.addAnimation (makeOptions (10.0)));
+
+        for (int i = 0; i < 100; i += 3)
+            engine.removeAnimation (ids[i]);
+
+        engine.removeAllAnimations();
+
+        for (auto id : ids)
+            expect (! engine.isAnimating (id));
+
+        Array<AnimationEngine::AnimationId> newIds;
+
+        for (int i = 0; i < 150; ++i)
+            newIds.add (engine.addAnimation (makeOptions (10.0)));
+
+        for (auto id : newIds)
+            expect (engine.isAnimating (id));
+
+        for (auto id : ids)
+            expect (! engine.isAnimating (id), "a released id must not match a new animation");
+
+        tickAndWait (engine, 1.0 / 60.0);
+        tickAndWait (engine, 1.0 / 60.0);
+        expectEquals (engine.getNumAnimations(), newIds.size());
+    }
+};
+
+static AnimationEngineTests animationEngineTests;
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+class AnimationPresetLibraryTests  : public UnitTest
+{
+public:
+    AnimationPresetLibraryTests()  : UnitTest ("AnimationPresetLibrary", "Animation") {}
+
+    void runTest() override
+    {
+        testReading();
+        testValueTreeRoundTrip();
+    }
+
+private:
+    using Variant = EasingFunctions::AnyEasing::Variant;
+
+    /** Adds one eased preset for every type of curve, some with non-default
+        parameters, and a keyframe preset.
+    */
+    template <size_t... indices>
+    static void addPresets (AnimationPresetLibrary::Writer& writer, std::index_sequence<indices...>)
+    {
+        (writer.addEased ("type" + String ((int) indices).paddedLeft ('0', 2), 0.1 * (indices + 1),
+                          (int) indices % 3 - 1, (indices & 1) != 0,
+                          std::variant_alternative_t<indices, Variant>()), ...);
+    }
+
+    static MemoryBlock createLibraryData()
+    {
+        using namespace EasingFunctions;
+
+        AnimationPresetLibrary::Writer writer;
+        addPresets (writer, std::make_index_sequence<std::variant_size<Variant>::value>());
+
+        writer.addEased ("back", 0.3, 0, false, EaseOutBack { 2.5 });
+        writer.addEased ("bezier", 0.45, 2, true, EaseCubicBezier (0.3, -0.2, 0.2, 1.4));
+        writer.addEased ("elastic", 1.25, -1, true, EaseOutElastic (1.2, 0.8));
+        writer.addEased (String::fromUTF8 ("\xc3\xa9lan"), 0.2, 0, false, EaseInOutQuad());
+
+        KeyframeTrack<double> track;
+        track.addKeyframe (0.0, 10.0, EaseOutBounce { 0.5 });
+        track.addKeyframe (0.5, -20.0, EaseCubicBezier (0.1, 0.9, 0.2, 1.0));
+        track.addKeyframe (1.75, 30.0);
+        writer.addKeyframes ("track", track);
+
+        return writer.createData();
+    }
+
+    //==============================================================================
+    void testReading()
+    {
+        beginTest ("Presets read back as they were written");
+
+        const auto data = createLibraryData();
+        AnimationPresetLibrary library (data.getData(), data.getSize());
+
+        expect (library.isValid());
+        expectEquals (library.getNumPresets(), (int) std::variant_size<Variant>::value + 5);
+
+        for (int i = 1; i < library.getNumPresets(); ++i)
+            expect (std::strcmp (library.getName (i - 1), library.getName (i)) < 0, "the presets must be sorted by name");
+
+        const int elastic = library.indexOf ("elastic");
+        expect (library.getKind (elastic) == AnimationPresetLibrary::Kind::eased);
+        expectEquals (library.getDuration (elastic), 1.25);
+        expectEquals (library.getLoops (elastic), -1);
+        expect (library.isPingPong (elastic));
+
+        const auto easing = library.getEasing (elastic);
+        const auto* curve = easing.getIf<EasingFunctions::EaseOutElastic>();
+        expect (curve != nullptr && curve->getAmplitude() == 1.2 && curve->getPeriod() == 0.8);
+
+        expect (library.indexOf ("\xc3\xa9lan") >= 0);
+        expectEquals (library.indexOf ("missing"), -1);
+
+        const int track = library.indexOf ("track");
+        expect (library.getKind (track) == AnimationPresetLibrary::Kind::keyframes);
+        expectEquals (library.getNumKeyframes (track), 3);
+        expectEquals (library.getKeyframe (track, 1).value, -20.0);
+        expectEquals (library.getKeyframe (track, 2).time, 1.75);
+
+        AnimatedPositionBehaviours::Eased<EasingFunctions::EaseOutBack> behaviour;
+        expect (library.applyTo (library.indexOf ("back"), behaviour));
+        expectEquals (behaviour.easing.overshoot, 2.5);
+        expect (! library.applyTo (elastic, behaviour), "an elastic curve can't go in an EaseOutBack");
+
+        beginTest ("Damaged data gives an empty library");
+
+        AnimationPresetLibrary truncated (data.getData(), data.getSize() / 2);
+        expect (! truncated.isValid());
+        expectEquals (truncated.getNumPresets(), 0);
+
+        MemoryBlock wrongMagic (data);
+        static_cast<char*> (wrongMagic.getData())[0] = 'X';
+        expect (! AnimationPresetLibrary (wrongMagic.getData(), wrongMagic.getSize()).isValid());
+    }
+
+    void testValueTreeRoundTrip()
+    {
+       #if JUCE_MODULE_AVAILABLE_juce_data_structures
+        beginTest ("Converting to a ValueTree and back gives the same bytes");
+
+        const auto data = createLibraryData();
+        AnimationPresetLibrary library (data.getData(), data.getSize());
+
+        AnimationPresetLibrary::Writer writer;
+        const auto result = writer.addFromValueTree (library.toValueTree());
+
+        expect (result.wasOk(), result.getErrorMessage());
+        expectEquals (writer.getNumPresets(), library.getNumPresets());
+
+        const auto roundTripped = writer.createData();
+        expect (roundTripped == data);
+       #else
+        logMessage ("Skipped: juce_data_structures isn't available");
+       #endif
+    }
+};
+
+static AnimationPresetLibraryTests animationPresetLibraryTests;
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+class AnimationTimelineTests  : public UnitTest
+{
+public:
+    AnimationTimelineTests()  : UnitTest ("AnimationTimeline", "Animation") {}
+
+    void runTest() override
+    {
+        using T = AnimationTimeline;
+
+        beginTest ("A sequence plays its clips one after another");
+
+        {
+            AnimationTimeline timeline;
+            const auto outCubic = timeline.addEasing (EasingFunctions::EaseOutCubic());
+
+            timeline.setComposition (T::sequence ({ T::clip (0, 1.0, 0.0, 10.0),
+                                                    T::delay (0.5),
+                                                    T::clip (0, 2.0, 10.0, 20.0, outCubic) }));
+
+            expectEquals (timeline.getDuration(), 3.5);
+            expectEquals (timeline.getNumSegments(), 2);
+
+            timeline.evaluate (0.5);
+            expectWithinAbsoluteError (timeline.getValue (0), 5.0, 1.0e-12);
+
+            timeline.evaluate (1.25);
+            expectWithinAbsoluteError (timeline.getValue (0), 10.0, 1.0e-12);
+
+            timeline.evaluate (2.5);
+            expectWithinAbsoluteError (timeline.getValue (0), 10.0 + 10.0 * EasingFunctions::EaseOutCubic() (0.5), 1.0e-12);
+
+            timeline.evaluate (10.0);
+            expectWithinAbsoluteError (timeline.getValue (0), 20.0, 1.0e-12);
+        }
+
+        beginTest ("Easings added after setComposition() are safe to tick");
+
+        {
+            AnimationTimeline timeline;
+            timeline.setComposition (T::parallel ({ T::clip (0, 1.0, 0.0, 1.0),
+                                                    T::clip (1, 2.0, 5.0, 7.0) }));
+
+            // registered for the next composition, so unused by this one
+            for (int i = 0; i < 64; ++i)
+                timeline.addEasing (EasingFunctions::EaseInOutSine());
+
+            timeline.advance (0.5);
+            expectWithinAbsoluteError (timeline.getValue (0), 0.5, 1.0e-12);
+            expectWithinAbsoluteError (timeline.getValue (1), 5.5, 1.0e-12);
+
+            const auto sine = timeline.addEasing (EasingFunctions::EaseInOutSine());
+            timeline.setComposition (T::clip (0, 1.0, 0.0, 1.0, sine));
+            timeline.evaluate (0.25);
+            expectWithinAbsoluteError (timeline.getValue (0), EasingFunctions::EaseInOutSine() (0.25), 1.0e-12);
+        }
+
+        beginTest ("A timeline without a composition has nothing to evaluate");
+
+        {
+            AnimationTimeline timeline;
+            timeline.addEasing (EasingFunctions::EaseOutBack());
+            timeline.advance (0.1);
+
+            expectEquals (timeline.getNumChannels(), 0);
+        }
+    }
+};
+
+static AnimationTimelineTests animationTimelineTests;
@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+class EasingCombinatorsTests  : public UnitTest
+{
+public:
+    EasingCombinatorsTests()  : UnitTest ("EasingCombinators", "Animation") {}
+
+    void runTest() override
+    {
+        testCombinators();
+        testTimeScale();
+        testProcessBlock();
+    }
+
+private:
+    static Array<double> getTestPositions()
+    {
+        Array<double> positions;
+
+        for (int i = 0; i <= 64; ++i)
+            positions.add (i / 64.0);
+
+        return positions;
+    }
+
+    template <typename EasingType, typename ExpectedFn>
+    void expectCurve (const EasingType& easing, ExpectedFn&& expected, const String& curveName)
+    {
+        for (auto t : getTestPositions())
+            expectWithinAbsoluteError (easing (t), expected (t), 1.0e-12, curveName + " at " + String (t));
+    }
+
+    template <typename EasingType>
+    void expectBlockMatchesFunctor (const EasingType& easing, const String& curveName)
+    {
+        const auto input = getTestPositions();
+        Array<double> output;
+        output.resize (input.size());
+
+        EasingFunctions::processBlock (easing, input.begin(), output.begin(), input.size());
+
+        for (int i = 0; i < input.size(); ++i)
+        {
+            const double expected = easing (input[i]);
+            expect (std::memcmp (&output.getReference (i), &expected, sizeof (double)) == 0,
+                    curveName + " at " + String (input[i]));
+        }
+    }
+
+    //==============================================================================
+    void testCombinators()
+    {
+        using namespace EasingFunctions;
+
+        beginTest ("Combinators compose the curves they hold");
+
+        const EaseInBack back;
+        const EaseOutCubic cubic;
+
+        expectCurve (Reverse<EaseInBack>(), [back] (double t) { return 1.0 - back (1.0 - t); }, "Reverse");
+        expectCurve (Mirror<EaseOutCubic>(), [cubic] (double t) { return cubic (t < 0.5 ? 2.0 * t : 2.0 - 2.0 * t); }, "Mirror");
+        expectCurve (OutIn<EaseInCubic>(), EaseOutInCubic(), "OutIn<EaseInCubic>");
+        expectCurve (InOut<EaseInQuad>(), EaseInOutQuad(), "InOut<EaseInQuad>");
+
+        expectCurve (Chain<EaseInBack, EaseOutCubic, std::ratio<1, 3>>(), [back, cubic] (double t)
+        {
+            return t < 1.0 / 3.0 ? back (3.0 * t) / 3.0
+                                 : 1.0 / 3.0 + 2.0 / 3.0 * cubic ((t - 1.0 / 3.0) * 1.5);
+        }, "Chain");
+    }
+
+    void testTimeScale()
+    {
+        using namespace EasingFunctions;
+
+        beginTest ("TimeScale plays the curve faster and then holds its end");
+
+        const EaseOutCubic cubic;
+        const TimeScale<EaseOutCubic, std::ratio<1, 2>> twice;
+
+        expectCurve (twice, [cubic] (double t) { return t < 0.5 ? cubic (2.0 * t) : 1.0; }, "TimeScale");
+        expectEquals (TimeScale<EaseOutBack, std::ratio<1, 1>>() (0.3), EaseOutBack() (0.3));
+
+        static constexpr double quarter = TimeScale<EaseInQuad, std::ratio<1, 4>>() (0.125);
+        expectEquals (quarter, 0.25);
+
+        for (auto t : { 0.1, 0.3, 0.45, 0.7 })
+        {
+            const double h = 1.0e-6;
+            expectWithinAbsoluteError (twice.derivative (t), (twice (t + h) - twice (t - h)) / (2.0 * h), 1.0e-5);
+        }
+
+        const TimeScale<EaseOutBack, std::ratio<2, 3>> overshoot (EaseOutBack { 3.0 });
+        expectEquals (overshoot (1.0 / 3.0), (EaseOutBack { 3.0 }) (0.5));
+    }
+
+    void testProcessBlock()
+    {
+        using namespace EasingFunctions;
+
+        beginTest ("Block processing of combinators gives the same bits as the functors");
+
+        expectBlockMatchesFunctor (Reverse<EaseInBack>(), "Reverse<EaseInBack>");
+        expectBlockMatchesFunctor (Mirror<EaseOutBounce>(), "Mirror<EaseOutBounce>");
+        expectBlockMatchesFunctor (Chain<EaseInBack, EaseOutCubic, std::ratio<1, 3>>(), "Chain");
+        expectBlockMatchesFunctor (OutIn<EaseInCubic>(), "OutIn<EaseInCubic>");
+        expectBlockMatchesFunctor (TimeScale<EaseOutCubic, std::ratio<1, 2>>(), "TimeScale<EaseOutCubic>");
+        expectBlockMatchesFunctor (TimeScale<InOut<EaseInCirc>, std::ratio<3, 4>>(), "TimeScale<InOut<EaseInCirc>>");
+
+        // curves without a vectorised kernel fall back to the scalar loop
+        expectBlockMatchesFunctor (TimeScale<EaseOutSine, std::ratio<1, 2>>(), "TimeScale<EaseOutSine>");
+
+        static_assert (SIMDDetail::HasVectorisedKernel<TimeScale<EaseOutCubic, std::ratio<1, 2>>>::value,
+                       "TimeScale of a vectorised curve should be vectorised");
+        static_assert (! SIMDDetail::HasVectorisedKernel<TimeScale<EaseOutSine, std::ratio<1, 2>>>::value,
+                       "TimeScale of a scalar curve should use the scalar loop");
+    }
+};
+
+static EasingCombinatorsTests easingCombinatorsTests;
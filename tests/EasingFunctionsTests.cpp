@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+class EasingFunctionsTests  : public UnitTest
+{
+public:
+    EasingFunctionsTests()  : UnitTest ("EasingFunctions", "Animation") {}
+
+    void runTest() override
+    {
+        testDerivatives();
+        testConstexprEasings();
+        testProcessBlock();
+    }
+
+private:
+    using Variant = EasingFunctions::AnyEasing::Variant;
+
+    /** Calls a function with a default-constructed instance of every type that
+        an AnyEasing can hold, along with its name.
+    */
+    template <typename Fn, size_t... indices>
+    static void forEachEasingType (Fn&& fn, std::index_sequence<indices...>)
+    {
+        (fn (std::variant_alternative_t<indices, Variant>(), (int) indices), ...);
+    }
+
+    template <typename Fn>
+    static void forEachEasingType (Fn&& fn)
+    {
+        forEachEasingType (std::forward<Fn> (fn), std::make_index_sequence<std::variant_size<Variant>::value>());
+    }
+
+    /** The positions that the curves are checked at. These stay clear of the
+        ends and of 0.5, where several curves have a jump or a vertical
+        tangent, e.g. the expo family is pinned to exactly 0 and 1 at the ends.
+    */
+    static Array<double> getTestPositions()
+    {
+        Array<double> positions;
+
+        for (int i = 0; i < 97; ++i)
+            positions.add ((i + 0.37) / 97.0);
+
+        return positions;
+    }
+
+    //==============================================================================
+    template <typename EasingType>
+    void expectDerivativeMatchesCurve (const EasingType& easing, const String& curveName)
+    {
+        constexpr double h = 1.0e-5;
+
+        for (auto t : getTestPositions())
+        {
+            const double numeric = (easing (t + h) - easing (t - h)) / (2.0 * h);
+
+            // skip the corners of the bounce curves, where the slope jumps
+            const double left  = (easing (t) - easing (t - h)) / h;
+            const double right = (easing (t + h) - easing (t)) / h;
+
+            if (std::abs (left - right) > 1.0e-2 * jmax (1.0, std::abs (numeric)))
+                continue;
+
+            expectWithinAbsoluteError (easing.derivative (t), numeric, 1.0e-5 * jmax (1.0, std::abs (numeric)),
+                                       curveName + " at " + String (t));
+        }
+    }
+
+    void testDerivatives()
+    {
+        beginTest ("The closed form derivatives match the curves");
+
+        forEachEasingType ([this] (const auto& easing, int index)
+        {
+            expectDerivativeMatchesCurve (easing, "type " + String (index));
+        });
+
+        beginTest ("The derivatives follow the curves' parameters");
+
+        using namespace EasingFunctions;
+
+        expectDerivativeMatchesCurve (EaseOutElastic (1.5, 0.4), "EaseOutElastic (1.5, 0.4)");
+        expectDerivativeMatchesCurve (EaseInOutElastic (0.8, 2.0), "EaseInOutElastic (0.8, 2.0)");
+        expectDerivativeMatchesCurve (EaseOutBack { 3.0 }, "EaseOutBack { 3.0 }");
+        expectDerivativeMatchesCurve (EaseOutBounce { 0.5 }, "EaseOutBounce { 0.5 }");
+        expectDerivativeMatchesCurve (EaseCubicBezier (0.1, 0.9, 0.2, 1.0), "EaseCubicBezier (0.1, 0.9, 0.2, 1.0)");
+        expectDerivativeMatchesCurve (EaseCubicBezier (0.5, -0.6, 0.5, 1.6), "EaseCubicBezier (0.5, -0.6, 0.5, 1.6)");
+
+        beginTest ("getDerivative() falls back to a central difference");
+
+        auto square = [] (double t) { return t * t; };
+
+        for (auto t : { 0.1, 0.5, 0.9 })
+            expectWithinAbsoluteError (getDerivative (square, t), 2.0 * t, 1.0e-6);
+    }
+
+    //==============================================================================
+    template <typename RuntimeType, typename ConstexprType>
+    void expectSameCurve (const RuntimeType& runtime, const ConstexprType& compileTime, const String& curveName)
+    {
+        for (auto t : getTestPositions())
+        {
+            const double value = runtime (t), slope = runtime.derivative (t);
+
+            expectWithinAbsoluteError (compileTime (t), value, 1.0e-12 * jmax (1.0, std::abs (value)),
+                                       curveName + " at " + String (t));
+            expectWithinAbsoluteError (compileTime.derivative (t), slope, 1.0e-12 * jmax (1.0, std::abs (slope)),
+                                       curveName + "'s slope at " + String (t));
+        }
+    }
+
+    void testConstexprEasings()
+    {
+        using namespace EasingFunctions;
+
+        beginTest ("The Constexpr easings can be evaluated at compile time");
+
+        static constexpr double elastic = Constexpr::EaseOutElastic (1.0, 0.3) (0.25);
+        static constexpr double circ = Constexpr::EaseInOutCirc() (0.75);
+        static constexpr double nanRoot = ConstexprMath::sqrt (std::numeric_limits<double>::quiet_NaN());
+
+        expectWithinAbsoluteError (elastic, EaseOutElastic (1.0, 0.3) (0.25), 1.0e-12);
+        expectWithinAbsoluteError (circ, EaseInOutCirc() (0.75), 1.0e-12);
+        expect (std::isnan (nanRoot));
+
+        beginTest ("The Constexpr easings follow the same curves as the runtime ones");
+
+        expectSameCurve (EaseInSine(),          Constexpr::EaseInSine(),          "EaseInSine");
+        expectSameCurve (EaseOutSine(),         Constexpr::EaseOutSine(),         "EaseOutSine");
+        expectSameCurve (EaseInOutSine(),       Constexpr::EaseInOutSine(),       "EaseInOutSine");
+        expectSameCurve (EaseOutInSine(),       Constexpr::EaseOutInSine(),       "EaseOutInSine");
+        expectSameCurve (EaseInExpo(),          Constexpr::EaseInExpo(),          "EaseInExpo");
+        expectSameCurve (EaseOutExpo(),         Constexpr::EaseOutExpo(),         "EaseOutExpo");
+        expectSameCurve (EaseInOutExpo(),       Constexpr::EaseInOutExpo(),       "EaseInOutExpo");
+        expectSameCurve (EaseOutInExpo(),       Constexpr::EaseOutInExpo(),       "EaseOutInExpo");
+        expectSameCurve (EaseInCirc(),          Constexpr::EaseInCirc(),          "EaseInCirc");
+        expectSameCurve (EaseOutCirc(),         Constexpr::EaseOutCirc(),         "EaseOutCirc");
+        expectSameCurve (EaseInOutCirc(),       Constexpr::EaseInOutCirc(),       "EaseInOutCirc");
+        expectSameCurve (EaseOutInCirc(),       Constexpr::EaseOutInCirc(),       "EaseOutInCirc");
+        expectSameCurve (EaseInElastic (1.5, 0.4),    Constexpr::EaseInElastic (1.5, 0.4),    "EaseInElastic");
+        expectSameCurve (EaseOutElastic (1.5, 0.4),   Constexpr::EaseOutElastic (1.5, 0.4),   "EaseOutElastic");
+        expectSameCurve (EaseInOutElastic (0.8, 2.0), Constexpr::EaseInOutElastic (0.8, 2.0), "EaseInOutElastic");
+        expectSameCurve (EaseOutInElastic (0.8, 2.0), Constexpr::EaseOutInElastic (0.8, 2.0), "EaseOutInElastic");
+    }
+
+    //==============================================================================
+    template <typename EasingType>
+    void expectBlockMatchesFunctor (const EasingType& easing, const Array<double>& input, const String& curveName)
+    {
+        // lengths that leave every possible tail after the full registers
+        for (int numValues = 1; numValues <= input.size(); numValues += 7)
+        {
+            HeapBlock<double> output ((size_t) numValues), inPlace ((size_t) numValues);
+            std::copy (input.begin(), input.begin() + numValues, inPlace.get());
+
+            EasingFunctions::processBlock (easing, input.begin(), output.get(), numValues);
+            EasingFunctions::processBlock (easing, inPlace.get(), inPlace.get(), numValues);
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                const double expected = easing (input[i]);
+
+                expect (std::memcmp (&output[i], &expected, sizeof (double)) == 0,
+                        curveName + " at " + String (input[i]) + ": " + String (output[i]) + " != " + String (expected));
+                expect (std::memcmp (&inPlace[i], &expected, sizeof (double)) == 0,
+                        curveName + " in place at " + String (input[i]));
+            }
+        }
+    }
+
+    void testProcessBlock()
+    {
+        beginTest ("Block processing gives the same bits as the functors");
+
+        Array<double> input { 0.0, 0.5, 1.0, 0.25, 0.75 };
+        auto random = getRandom();
+
+        while (input.size() < 103)
+            input.add (random.nextDouble());
+
+        input.add (1.0);
+
+        forEachEasingType ([this, &input] (const auto& easing, int index)
+        {
+            expectBlockMatchesFunctor (easing, input, "type " + String (index));
+        });
+
+        using namespace EasingFunctions;
+
+        expectBlockMatchesFunctor (EaseOutBack { 3.0 }, input, "EaseOutBack { 3.0 }");
+        expectBlockMatchesFunctor (EaseInOutBack { 0.5 }, input, "EaseInOutBack { 0.5 }");
+        expectBlockMatchesFunctor (EaseOutBounce { 0.5 }, input, "EaseOutBounce { 0.5 }");
+        expectBlockMatchesFunctor (EaseOutInBounce { 2.0 }, input, "EaseOutInBounce { 2.0 }");
+        expectBlockMatchesFunctor (EaseCubicBezier (0.1, 0.9, 0.2, 1.0), input, "EaseCubicBezier (0.1, 0.9, 0.2, 1.0)");
+        expectBlockMatchesFunctor (EaseCubicBezier (0.5, -0.6, 0.5, 1.6), input, "EaseCubicBezier (0.5, -0.6, 0.5, 1.6)");
+
+        // the cubic Bezier kernel hands values outside [0, 1] back to the functor
+        expectBlockMatchesFunctor (EaseCubicBezier (0.25, 0.1, 0.25, 1.0), { -0.5, -0.1, 1.1, 1.5, 0.3 }, "EaseCubicBezier outside [0, 1]");
+    }
+};
+
+static EasingFunctionsTests easingFunctionsTests;
@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+/*  Unit tests for juce_animation.
+
+    Usage: juce_animation_tests [--seed <n>]
+
+    Runs every UnitTest in the "Animation" category and returns a non-zero exit
+    code if any of them fail, so that it can be run by ctest.
+*/
+
+#include <juce_animation/juce_animation.h>
+#include <iostream>
+
+using namespace juce;
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    ArgumentList args (argc, argv);
+
+    // the engine and clock tests need a message manager
+    ScopedJuceInitialiser_GUI libraryInitialiser;
+
+    const auto seed = args.containsOption ("--seed")
+                        ? args.getValueForOption ("--seed").getLargeIntValue()
+                        : Random::getSystemRandom().nextInt64();
+
+    UnitTestRunner runner;
+    runner.setAssertOnFailure (false);
+    runner.runTestsInCategory ("Animation", seed);
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult (i)->failures;
+
+    if (numFailures > 0)
+    {
+        std::cerr << numFailures << " test(s) failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
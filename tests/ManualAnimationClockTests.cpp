@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+  This file is part of juce_animation.
+  Copyright (c) 2018 - Antonio Lassandro
+
+  juce_animation is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  juce_animation is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with juce_animation.  If not, see <http://www.gnu.org/licenses/>.
+
+  ==============================================================================
+*/
+
+
+#include <juce_animation/juce_animation.h>
+
+using namespace juce;
+
+//==============================================================================
+class ManualAnimationClockTests  : public UnitTest
+{
+public:
+    ManualAnimationClockTests()  : UnitTest ("ManualAnimationClock", "Animation") {}
+
+    void runTest() override
+    {
+        beginTest ("Attached engines and timelines move with the clock");
+
+        {
+            ManualAnimationClock clock (50.0);
+
+            AnimationEngine engine;
+            AnimationEngine::Options options;
+            options.duration = 1.0;
+            options.endValue = 100.0;
+            const auto id = engine.addAnimation (options);
+
+            AnimationTimeline timeline;
+            timeline.setComposition (AnimationTimeline::clip (0, 2.0, 0.0, 1.0));
+
+            clock.attach (engine);
+            clock.attach (timeline);
+
+            expect (! engine.isTimerEnabled());
+
+            clock.advance (25);
+
+            expectEquals (clock.getFrame(), (int64) 25);
+            expectWithinAbsoluteError (clock.getTime(), 0.5, 1.0e-12);
+            expectWithinAbsoluteError (engine.getValue (id), 50.0, 1.0e-9);
+            expectWithinAbsoluteError (timeline.getValue (0), 0.25, 1.0e-12);
+
+            clock.advanceToFrame (100);
+            expect (! engine.isAnimating (id));
+            expectWithinAbsoluteError (timeline.getValue (0), 1.0, 1.0e-12);
+        }
+
+        beginTest ("Callbacks can attach more callbacks while the clock is ticking");
+
+        {
+            ManualAnimationClock clock;
+            int numCalls = 0, numLateCalls = 0;
+
+            clock.attach ([&] (double)
+            {
+                ++numCalls;
+
+                // enough to make the list of callbacks reallocate
+                if (clock.getFrame() == 1)
+                    for (int i = 0; i < 100; ++i)
+                        clock.attach ([&numLateCalls] (double) { ++numLateCalls; });
+            });
+
+            clock.advance();
+
+            expectEquals (numCalls, 1);
+            expectEquals (numLateCalls, 0);
+
+            clock.advance (2);
+
+            expectEquals (numCalls, 3);
+            expectEquals (numLateCalls, 200);
+        }
+    }
+};
+
+static ManualAnimationClockTests manualAnimationClockTests;